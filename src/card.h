@@ -3,44 +3,18 @@
 
 #include "SDL3/SDL_rect.h"
 #include "SDL3/SDL_render.h"
+#include "cardtypes.h"
+#include "tarot.h"
+#include <array>
 #include <cstddef>
-#include <deque>
-#include <functional>
-#include <memory>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
-#include <vector>
-
-enum class CardRank
-{
-    TWO = 2,
-    THREE,
-    FOUR,
-    FIVE,
-    SIX,
-    SEVEN,
-    EIGHT,
-    NINE,
-    TEN,
-    JACK,
-    QUEEN,
-    KING,
-    ACE
-};
-
-enum class CardSuits
-{
-    CLUBS,    // ♣
-    SPADES,   // ♠
-    DIAMONDS, // ♦
-    HEARTS    // ♥
-};
-
 
 std::string getCardName(CardRank value);
 
 std::string getCardSuit(CardSuits suit);
 
+// what never changes about a card, one entry per CardId in the card table
 struct Card
 {
     std::string name;
@@ -48,96 +22,38 @@ struct Card
     SDL_FRect tex_rect;
     CardRank rank;
     CardSuits suit;
-    bool selected = false;
-};
-
-struct HandRank
-{
-    int chips;
-    int multiplier;
-    int used = 0;
-};
-
-class CardManager
-{
-public:
-    int max_selected_cards = 5;
-    int count_selected_card = 0;
-    std::deque<std::unique_ptr<Card>> m_cards;
-    std::vector<std::unique_ptr<Card>> m_hand_cards;
-    std::vector<std::unique_ptr<Card>> m_played_cards;
-    std::unordered_map<std::string, HandRank> hand_ranks; // <hand name, hand rank>
-    std::string m_hand_name = "High Card";
-
-    CardManager();
-
-    void resetCards();
-
-    void shuffleCards();
-
-    void getNewShowedCards();
-
-    void selectCard(size_t index);
-
-    void deleteSelectedCards();
-    void playSelectedCards();
-
-    bool isStraightFlush();
-    bool isFourOfAKind();
-    bool isFullHouse();
-    bool isFlush();
-    bool isStraight();
-    bool isThreeOfAKind();
-    bool isTwoPair();
-    bool isPair();
 };
 
-// forward declaration
-class Game;
+// the 52 cards indexed by CardId, built from the card atlas on first use
+const std::array<Card, deck_size> &getCardTable();
 
-struct TarotAction
+inline const Card &getCard(CardId id)
 {
-    int multiplier;
-    std::string description;
-    std::function<void(Game *, int)> action;
-};
+    return getCardTable()[id];
+}
 
+// what the player sees of a tarot, what it does lives in the TarotEffects
 struct Tarot
 {
     std::string name;
     SDL_Texture *atlas;
     SDL_FRect tex_rect;
-    TarotAction action;
-    bool selected = false;
+    std::string description;
 };
 
+// the 22 tarots indexed by TarotId, built from the tarot atlas once
 class TarotManager
 {
-public:
-    std::unordered_map<std::string, TarotAction> tarots_actions;
-    std::deque<std::unique_ptr<Tarot>> m_tarots;
-    std::vector<std::unique_ptr<Tarot>> m_hand_tarots;
-    std::vector<std::unique_ptr<Tarot>> m_showed_tarots;
-    size_t m_showed_selected_tarots;
-    size_t m_selected_tarots;
+private:
+    std::array<Tarot, tarot_count> m_tarot_pool;
 
+public:
     TarotManager();
 
-    void shuffleTarots();
-
-    void resetTarots(int round);
-
-    void getNewShowedTarots();
-
-    void selectShowedTarot(size_t index);
-
-    void moveToHand();
-
-    void selectTarot(size_t index);
-
-    void deleteSelectedTarots();
+    // descriptions come from the effects file, loaded after the atlas
+    void setDescriptions(const TarotEffects &effects);
 
-    void applyTarots(Game *game);
+    const Tarot &getTarot(TarotId id) const;
 };
 
 #endif // SRC_CARD_H
@@ -0,0 +1,276 @@
+#include "cardmanager.h"
+#include "handevaluator.h"
+#include "handrules.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+namespace
+{
+// every card id in suit then rank order, copied over the draw pile on a reset
+constexpr DrawPile<CardId, deck_size> full_deck = [] {
+    DrawPile<CardId, deck_size> deck;
+    for (int id = 0; id < deck_size; id++)
+    {
+        deck.push_back(id);
+    }
+    return deck;
+}();
+} // namespace
+
+CardManager::CardManager()
+{
+    hand_ranks = default_hand_ranks;
+    resetCards();
+}
+
+HandRank &CardManager::getHandRank(HandType type)
+{
+    return hand_ranks[static_cast<int>(type)];
+}
+
+HandRank CardManager::previewHandRank(HandType type)
+{
+    HandRank rank = getHandRank(type);
+    rank.used++;
+    rank.chips += rank.used % 3 == 0 ? 10 : 0;
+    rank.multiplier += rank.used % 3 == 0 ? 1 : 0;
+    return rank;
+}
+
+HandRank CardManager::useHandRank(HandType type)
+{
+    HandRank &rank = getHandRank(type);
+    rank = previewHandRank(type);
+    return rank;
+}
+
+void CardManager::resetCards()
+{
+    // start from the same order every time so a run only depends on the seed
+    m_cards = full_deck;
+}
+
+void CardManager::getNewShowedCards()
+{
+    int n = m_hand_cards.capacity() - m_hand_cards.size();
+    if (m_cards.size() < n)
+    {
+        resetCards();
+    }
+    for (int i = 0; i < n; i++)
+    {
+        m_hand_cards.push_back(m_cards.draw(rng));
+    }
+    // nothing is selected when new cards come in, so moving cards can't break m_selected_mask
+    std::sort(m_hand_cards.begin(), m_hand_cards.end(), [](CardId a, CardId b) {
+        return cardRank(a) > cardRank(b);
+    });
+}
+
+void CardManager::selectCard(size_t index)
+{
+    if (index < 0 || index >= m_hand_cards.size())
+    {
+        return;
+    }
+
+    // toggle
+    bool selected = isSelected(index);
+    int current_count = count_selected_card;
+    current_count += selected ? -1 : 1;
+
+    if (current_count > max_selected_cards)
+    {
+        return;
+    }
+
+    count_selected_card = current_count;
+    CardId card = m_hand_cards[index];
+    m_selected_mask ^= uint64_t(1) << index;
+
+    // only the toggled card changes the counts, no need to look at the rest of the hand
+    if (!selected)
+    {
+        m_selected_hand.add(cardRank(card), cardSuit(card));
+    }
+    else
+    {
+        m_selected_hand.remove(cardRank(card), cardSuit(card));
+    }
+    m_hand_type = getHandType(lookupHand(m_selected_hand));
+}
+
+bool CardManager::isSelected(size_t index) const
+{
+    return index < 64 && (m_selected_mask >> index) & 1;
+}
+
+void CardManager::clearSelection()
+{
+    count_selected_card = 0;
+    m_selected_mask = 0;
+    m_selected_hand = HandMask();
+}
+
+void CardManager::resetHand()
+{
+    m_hand_cards.clear();
+    clearSelection();
+}
+
+void CardManager::deleteSelectedCards()
+{
+    // compact the unselected cards to the front of the hand
+    size_t kept = 0;
+    for (size_t i = 0; i < m_hand_cards.size(); i++)
+    {
+        if (!isSelected(i))
+        {
+            m_hand_cards[kept++] = m_hand_cards[i];
+        }
+    }
+    m_hand_cards.count = kept;
+    clearSelection();
+    getNewShowedCards();
+}
+
+void CardManager::playSelectedCards()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < m_hand_cards.size(); i++)
+    {
+        if (isSelected(i))
+        {
+            m_played_cards.push_back(m_hand_cards[i]);
+        }
+        else
+        {
+            m_hand_cards[kept++] = m_hand_cards[i];
+        }
+    }
+    m_hand_cards.count = kept;
+    clearSelection();
+}
+
+namespace
+{
+constexpr int countPlayMasks()
+{
+    int count = 0;
+    for (unsigned mask = 1; mask < (1u << max_hand_cards); mask++)
+    {
+        count += std::popcount(mask) <= max_play_cards;
+    }
+    return count;
+}
+
+// every selection of 1 to 5 cards out of a full hand as a bitmask over hand indices, ascending
+constexpr std::array<uint16_t, countPlayMasks()> play_masks = [] {
+    std::array<uint16_t, countPlayMasks()> masks{};
+    int count = 0;
+    for (unsigned mask = 1; mask < (1u << max_hand_cards); mask++)
+    {
+        if (std::popcount(mask) <= max_play_cards) masks[count++] = mask;
+    }
+    return masks;
+}();
+
+static_assert(play_masks.size() == 381);
+} // namespace
+
+BestPlay CardManager::findBestPlay()
+{
+    size_t hand_size = std::min(m_hand_cards.size(), static_cast<size_t>(max_hand_cards));
+    CardRank ranks[max_hand_cards];
+    CardSuits suits[max_hand_cards];
+    for (size_t i = 0; i < hand_size; i++)
+    {
+        ranks[i] = cardRank(m_hand_cards[i]);
+        suits[i] = cardSuit(m_hand_cards[i]);
+    }
+
+    // what each hand type would score with, worked out once instead of per selection
+    std::array<HandRank, hand_type_count> next_ranks;
+    for (int i = 0; i < hand_type_count; i++)
+    {
+        next_ranks[i] = previewHandRank(static_cast<HandType>(i));
+    }
+
+    BestPlay best;
+    for (uint16_t mask : play_masks)
+    {
+        // masks are ascending, so the first one past the hand ends the search
+        if (mask >> hand_size) break;
+        if (std::popcount(mask) > max_selected_cards) continue;
+
+        HandMask hand;
+        int chips = 0;
+        for (unsigned bits = mask; bits != 0; bits &= bits - 1)
+        {
+            int i = std::countr_zero(bits);
+            hand.add(ranks[i], suits[i]);
+            chips += getCardChips(ranks[i]);
+        }
+
+        HandValue value = lookupHand(hand);
+        HandRank &rank = next_ranks[static_cast<int>(getHandType(value))];
+        int score = (rank.chips + chips) * rank.multiplier;
+        if (score > best.score || (score == best.score && value > best.value))
+        {
+            best = {mask, getHandType(value), value, score};
+        }
+    }
+    return best;
+}
+
+HandCounts CardManager::selectedCounts()
+{
+    HandCounts counts;
+    for (size_t i = 0; i < m_hand_cards.size(); i++)
+    {
+        if (!isSelected(i)) continue;
+        counts.add(cardRank(m_hand_cards[i]), cardSuit(m_hand_cards[i]));
+    }
+    return counts;
+}
+
+bool CardManager::isStraightFlush()
+{
+    return hand_rules::isStraightFlush(selectedCounts());
+}
+
+bool CardManager::isFourOfAKind()
+{
+    return hand_rules::isFourOfAKind(selectedCounts());
+}
+
+bool CardManager::isFullHouse()
+{
+    return hand_rules::isFullHouse(selectedCounts());
+}
+
+bool CardManager::isFlush()
+{
+    return hand_rules::isFlush(selectedCounts());
+}
+
+bool CardManager::isStraight()
+{
+    return hand_rules::isStraight(selectedCounts());
+}
+
+bool CardManager::isThreeOfAKind()
+{
+    return hand_rules::isThreeOfAKind(selectedCounts());
+}
+
+bool CardManager::isTwoPair()
+{
+    return hand_rules::isTwoPair(selectedCounts());
+}
+
+bool CardManager::isPair()
+{
+    return hand_rules::isPair(selectedCounts());
+}
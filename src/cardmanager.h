@@ -0,0 +1,83 @@
+#ifndef SRC_CARDMANAGER_H
+#define SRC_CARDMANAGER_H
+
+// deck, hand and hand ranks of a run, free of SDL like the rest of the game core
+
+#include "cardtypes.h"
+#include "handevaluator.h"
+#include "handrules.h"
+#include "random.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+constexpr int max_hand_cards = 9;
+constexpr int max_play_cards = 5;
+
+// result of CardManager::findBestPlay
+struct BestPlay
+{
+    uint64_t mask = 0; // one bit per index in m_hand_cards
+    HandType type = HandType::HIGH_CARD;
+    HandValue value = 0;
+    int score = 0;
+};
+
+class CardManager
+{
+public:
+    int max_selected_cards = 5;
+    int count_selected_card = 0;
+    uint64_t m_selected_mask = 0; // one bit per index in m_hand_cards, so at most 64 cards
+    HandMask m_selected_hand;     // running counts of the selected cards
+    DrawPile<CardId, deck_size> m_cards;
+    CardList<max_hand_cards> m_hand_cards;
+    CardList<max_play_cards> m_played_cards;
+    std::array<HandRank, hand_type_count> hand_ranks; // indexed by HandType
+    HandType m_hand_type = HandType::HIGH_CARD;
+    Pcg32 rng; // deck stream, seeded by the game
+
+    CardManager();
+
+    HandRank &getHandRank(HandType type);
+
+    // rank the hand type scores with the next time it's played, every 3rd play upgrades it
+    HandRank previewHandRank(HandType type);
+
+    // count a play of the hand type and return the rank it scores with
+    HandRank useHandRank(HandType type);
+
+    // put every card back in the draw pile
+    void resetCards();
+
+    void getNewShowedCards();
+
+    void selectCard(size_t index);
+
+    bool isSelected(size_t index) const;
+
+    void clearSelection();
+
+    // drop every card in hand along with the selection
+    void resetHand();
+
+    void deleteSelectedCards();
+    void playSelectedCards();
+
+    // try every selection of up to max_selected_cards cards and return the highest scoring one
+    BestPlay findBestPlay();
+
+    // counts of the selected cards for the reference predicates below
+    HandCounts selectedCounts();
+
+    bool isStraightFlush();
+    bool isFourOfAKind();
+    bool isFullHouse();
+    bool isFlush();
+    bool isStraight();
+    bool isThreeOfAKind();
+    bool isTwoPair();
+    bool isPair();
+};
+
+#endif // SRC_CARDMANAGER_H
@@ -0,0 +1,156 @@
+#ifndef SRC_CARDTYPES_H
+#define SRC_CARDTYPES_H
+
+// plain card enums, kept free of SDL so the hand logic can be used without a renderer
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+enum class CardRank
+{
+    TWO = 2,
+    THREE,
+    FOUR,
+    FIVE,
+    SIX,
+    SEVEN,
+    EIGHT,
+    NINE,
+    TEN,
+    JACK,
+    QUEEN,
+    KING,
+    ACE
+};
+
+enum class CardSuits
+{
+    CLUBS,    // ♣
+    SPADES,   // ♠
+    DIAMONDS, // ♦
+    HEARTS    // ♥
+};
+
+// chips a card adds to the hand when it's scored
+constexpr int getCardChips(CardRank rank)
+{
+    return static_cast<int>(rank);
+}
+
+// a card as suit * 13 + (rank - 2), the same order as the bits of a CardMask
+using CardId = uint8_t;
+
+constexpr int deck_size = 52;
+
+constexpr CardId makeCardId(CardRank rank, CardSuits suit)
+{
+    return static_cast<CardId>(static_cast<int>(suit) * 13 + static_cast<int>(rank) - 2);
+}
+
+constexpr CardRank cardRank(CardId id)
+{
+    return static_cast<CardRank>(id % 13 + 2);
+}
+
+constexpr CardSuits cardSuit(CardId id)
+{
+    return static_cast<CardSuits>(id / 13);
+}
+
+static_assert(makeCardId(CardRank::ACE, CardSuits::HEARTS) == deck_size - 1);
+static_assert(cardRank(makeCardId(CardRank::TEN, CardSuits::SPADES)) == CardRank::TEN);
+static_assert(cardSuit(makeCardId(CardRank::TEN, CardSuits::SPADES)) == CardSuits::SPADES);
+
+// fixed capacity list of small ids, copying one is a plain memcpy
+template <typename T, size_t N> struct FixedList
+{
+    static_assert(N <= 255, "count is stored in a byte");
+
+    std::array<T, N> ids{};
+    uint8_t count = 0;
+
+    constexpr size_t size() const
+    {
+        return count;
+    }
+
+    constexpr size_t capacity() const
+    {
+        return N;
+    }
+
+    constexpr bool empty() const
+    {
+        return count == 0;
+    }
+
+    constexpr void clear()
+    {
+        count = 0;
+    }
+
+    constexpr bool full() const
+    {
+        return count == N;
+    }
+
+    constexpr void push_back(T id)
+    {
+        ids[count++] = id;
+    }
+
+    constexpr T pop_back()
+    {
+        return ids[--count];
+    }
+
+    constexpr T back() const
+    {
+        return ids[count - 1];
+    }
+
+    // remove one id and keep the order of the rest
+    constexpr void erase(size_t index)
+    {
+        for (size_t i = index + 1; i < count; i++)
+        {
+            ids[i - 1] = ids[i];
+        }
+        count--;
+    }
+
+    constexpr T &operator[](size_t index)
+    {
+        return ids[index];
+    }
+
+    constexpr T operator[](size_t index) const
+    {
+        return ids[index];
+    }
+
+    constexpr T *begin()
+    {
+        return ids.data();
+    }
+
+    constexpr T *end()
+    {
+        return ids.data() + count;
+    }
+
+    constexpr const T *begin() const
+    {
+        return ids.data();
+    }
+
+    constexpr const T *end() const
+    {
+        return ids.data() + count;
+    }
+};
+
+template <size_t N> using CardList = FixedList<CardId, N>;
+
+#endif // SRC_CARDTYPES_H
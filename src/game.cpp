@@ -1,31 +1,62 @@
 #include "game.h"
+#include "random.h"
+#include <SDL3/SDL_clipboard.h>
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_log.h>
 #include <string>
+#include <vector>
 
-float getStageScoreMult(int stage)
+namespace
 {
-    switch (stage)
+
+// where the autosave goes, next to the other per-user files of the game. empty if there is
+// nowhere to write, ends with a separator otherwise.
+std::string getSaveDir()
+{
+    char *pref_path = SDL_GetPrefPath("usernob", "builder-deck");
+    if (!pref_path)
     {
-        case 1:
-            return 1.0f;
-        case 2:
-            return 1.12f;
-        case 3:
-            return 1.32f;
-        default:
-            return 1.0f;
+        return "";
     }
+    std::string dir = pref_path;
+    SDL_free(pref_path);
+    return dir;
 }
 
+} // namespace
+
 Game::Game()
 {
-    card_manager.resetCards();
+    // build the card table now instead of on the first deal
+    getCardTable();
+    std::string error;
+    if (loadTarotEffects(ASSETS_PATH "/data/tarots.txt", m_tarot_effects, error))
+    {
+        tarot_manager.setDescriptions(m_tarot_effects);
+    }
+    else
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Tarots do nothing: %s", error.c_str());
+    }
+    rules.setTarotEffects(&m_tarot_effects);
+    rules.onEvent([this](const GameEvent &event) { onGameEvent(event); });
     main_menu_page = std::make_unique<MainMenu>(this);
     game_page = std::make_unique<GamePage>(this);
     current_page = main_menu_page.get();
+    m_save_dir = getSaveDir();
+    if (!m_save_dir.empty())
+    {
+        m_journal.open(m_save_dir);
+    }
+    updateSeedLabel();
+    updateSettingsLabels();
+    updateContinueButton();
 }
 
 Game::~Game()
 {
+    m_journal.close();
     main_menu_page.reset();
     game_page.reset();
 }
@@ -33,23 +64,18 @@ Game::~Game()
 void Game::toMainMenu()
 {
     current_page = main_menu_page.get();
-    state = State::MAIN_MENU;
+    updateContinueButton();
 }
 
 void Game::toGame()
 {
     current_page = game_page.get();
-    state = State::GAME;
-
-    game_page->play_counter->setText(std::string("Play: " + std::to_string(play_counter)).c_str());
-    game_page->play_button->setActive(true);
-    game_page->discard_counter->setText(
-        std::string("Discard: " + std::to_string(discard_counter)).c_str()
-    );
-    game_page->discard_button->setActive(true);
-
+    m_sequencer.cancelAll();
     newGame();
     newRound();
+    // the rules don't announce a phase for a fresh run, its first checkpoint is taken here
+    m_run_active = true;
+    compactJournal();
 }
 
 void Game::render(SDL_Renderer *renderer)
@@ -59,72 +85,155 @@ void Game::render(SDL_Renderer *renderer)
 
 void Game::update(float dt)
 {
-    if (state == State::GAME_CALCULATING)
+    int steps = clock.advance(dt);
+    for (int i = 0; i < steps; i++)
+    {
+        step();
+    }
+}
+
+void Game::step()
+{
+    // scoring waits while the player is in the menu
+    if (current_page == game_page.get())
+    {
+        m_sequencer.advance(GameClock::step_ms);
+    }
+    current_page->update(GameClock::step_seconds);
+}
+
+uint32_t Game::scoringDelay(uint32_t ms) const
+{
+    switch (m_scoring_speed)
+    {
+        case ScoringSpeed::FAST:
+            return ms / 2;
+        case ScoringSpeed::FASTER:
+            return ms / 4;
+        default:
+            return ms;
+    }
+}
+
+Sequence Game::scoreHand()
+{
+    // the rules don't know about time, pace the trace playback here
+    while (rules.state.phase == GamePhase::SCORING)
+    {
+        co_await Wait{scoringDelay(500)};
+        rules.scoreNextStep();
+    }
+    co_await Wait{scoringDelay(1000)};
+    resolveHand();
+}
+
+void Game::onGameEvent(const GameEvent &event)
+{
+    const GameState &state = rules.state;
+    switch (event.type)
     {
-        unsigned int current_tick = SDL_GetTicks();
-        if (current_tick - last_tick > 500)
+        case GameEventType::RESET:
+            updateComboWidget();
+            updateInfoRound();
+            updateCountersWidget();
+            updateHandCardsWidget();
+            hidePlayedCardsWidget();
+            updateActionButtons();
+            updateTarotsWidget();
+            break;
+        case GameEventType::HAND_CHANGED:
+            updateHandCardsWidget();
+            updateActionButtons();
+            break;
+        case GameEventType::CARD_SELECTED:
+            game_page->hand_card[event.index]->setSelected(
+                state.card_manager.isSelected(event.index)
+            );
+            break;
+        case GameEventType::PLAYED_CHANGED:
+            hidePlayedCardsWidget();
+            updatePlayedCardsWidget();
+            break;
+        case GameEventType::COMBO_CHANGED:
+            updateComboWidget();
+            break;
+        case GameEventType::INFO_CHANGED:
+            updateInfoRound();
+            break;
+        case GameEventType::COUNTERS_CHANGED:
+            updateCountersWidget();
+            break;
+        case GameEventType::CARD_SCORED:
+            hidePlayedScores();
+            game_page->played_card[event.index]->setRenderScore(true);
+            break;
+        case GameEventType::TAROT_SCORED:
         {
-            last_tick = current_tick;
-            if (last_card_index < card_manager.m_played_cards.size())
+            // the step just played back, its text goes over the tarot
+            const ScoreStep &step = state.score_trace.steps[state.trace_cursor - 1];
+            std::string text;
+            if (step.times != 1)
             {
-                auto &card = card_manager.m_played_cards[last_card_index];
-                m_current_hand_rank.chips += static_cast<int>(card->rank);
-                updateComboWidget();
-                if (last_card_index != 0)
-                {
-                    game_page->played_card[last_card_index - 1]->setRenderScore(false);
-                }
-                game_page->played_card[last_card_index]->setRenderScore(true);
-                last_card_index++;
+                text = "x" + std::to_string(step.times) + " mult";
+            }
+            else if (step.chips != 0 && step.mult != 0)
+            {
+                text = "+" + std::to_string(step.chips) + " +" + std::to_string(step.mult);
+                text += " mult";
+            }
+            else if (step.chips != 0)
+            {
+                text = "+" + std::to_string(step.chips);
             }
             else
             {
-                game_page->played_card[last_card_index - 1]->setRenderScore(false);
-                m_score += m_current_hand_rank.chips * m_current_hand_rank.multiplier;
-                updateInfoRound();
-                state = State::GAME_SCORING;
+                text = "+" + std::to_string(step.mult) + " mult";
             }
+            if (step.card < 0)
+            {
+                hidePlayedScores();
+            }
+            CardWidget *tarot = game_page->tarot_active[event.index];
+            tarot->setScoreText(text.c_str());
+            tarot->setRenderScore(true);
+            break;
         }
-    }
-    if (state == State::GAME_SCORING)
-    {
-        unsigned int current_tick = SDL_GetTicks();
-        if (current_tick - last_tick > 1000)
-        {
-            last_tick = current_tick;
-
-            if (m_score >= m_target_score)
+        case GameEventType::TAROTS_CHANGED:
+            m_selected_tarot = -1;
+            updateTarotsWidget();
+            updateOfferWidget();
+            break;
+        case GameEventType::PHASE_CHANGED:
+            updateActionButtons();
+            m_run_active = state.phase != GamePhase::GAME_OVER;
+            if (!m_run_active)
             {
-                nextRound();
+                m_journal.clear();
             }
-            else
+            if (state.phase == GamePhase::SCORED)
             {
-                card_manager.m_played_cards.clear();
-                m_current_hand_rank = {0, 1};
-                card_manager.m_hand_name = "High Card";
-                updateComboWidget();
-                updateInfoRound();
-                game_page->play_button->setActive(true);
-                game_page->discard_button->setActive(true);
-                card_manager.getNewShowedCards();
-                updateHandCardsWidget();
-                hidePlayedCardsWidget();
-                game_page->play_counter->setText(
-                    std::string("Play: " + std::to_string(play_counter)).c_str()
+                hidePlayedScores();
+            }
+            else if (state.phase == GamePhase::ROUND_WON)
+            {
+                const RoundReward &reward = state.reward;
+                game_page->play_reward->setText(
+                    std::string("$" + std::to_string(reward.play)).c_str()
                 );
-                game_page->discard_counter->setText(
-                    std::string("Discard: " + std::to_string(discard_counter)).c_str()
+                game_page->discard_reward->setText(
+                    std::string("$" + std::to_string(reward.discard)).c_str()
                 );
-
-                if (play_counter == 0)
-                {
-                    game_page->push(game_page->game_over_overlay);
-                }
+                game_page->total_reward->setText(
+                    std::string("$" + std::to_string(reward.total)).c_str()
+                );
+                game_page->push(game_page->win_round_overlay);
             }
-            state = State::GAME;
-        }
+            else if (state.phase == GamePhase::GAME_OVER)
+            {
+                game_page->push(game_page->game_over_overlay);
+            }
+            break;
     }
-    current_page->update(dt);
 }
 
 void Game::updateHandCardsWidget()
@@ -132,9 +241,10 @@ void Game::updateHandCardsWidget()
     for (int i = 0; i < game_page->hand_card.size(); i++)
     {
         auto hand_card = game_page->hand_card[i];
-        if (i < card_manager.m_hand_cards.size())
+        hand_card->setSuggested(false);
+        if (i < rules.state.card_manager.m_hand_cards.size())
         {
-            hand_card->setCard(card_manager.m_hand_cards[i].get());
+            hand_card->setCard(&getCard(rules.state.card_manager.m_hand_cards[i]));
             hand_card->resetPosition();
             hand_card->setVisible(true);
             hand_card->setActive(true);
@@ -148,43 +258,238 @@ void Game::updateHandCardsWidget()
 
 void Game::registerMouseEvents(SDL_Event *event)
 {
+    GamePhase phase = rules.state.phase;
+    bool scoring = phase == GamePhase::SCORING || phase == GamePhase::SCORED;
+    if (m_click_to_skip && scoring && current_page == game_page.get() &&
+        event->type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+    {
+        // buttons like speed still work while a hand is counted, a click anywhere else skips.
+        // that click only skips, it doesn't reach the cards that come back into play
+        SDL_FPoint mouse = {event->button.x, event->button.y};
+        if (!game_page->hitsActiveWidget(mouse))
+        {
+            skipScoring();
+            return;
+        }
+    }
     current_page->registerMouseEvents(event);
 }
 
-void Game::nextStage()
+void Game::requestExit()
+{
+    m_exit = true;
+}
+
+void Game::setSeed(uint64_t seed)
+{
+    m_seed = seed;
+    m_seed_fixed = true;
+    updateSeedLabel();
+}
+
+uint64_t Game::getSeed() const
 {
-    m_stage_counter++;
-    card_manager.resetCards();
+    return m_seed;
+}
+
+bool Game::isSeedFixed() const
+{
+    return m_seed_fixed;
+}
+
+void Game::setNextRunSeed(uint64_t seed)
+{
+    m_next_seed = seed;
+}
 
-    m_round_counter = 1;
-    m_target_score += 200;
+uint32_t Game::getRunsStarted() const
+{
+    return m_runs_started;
 }
 
-void Game::nextRound()
+void Game::pasteSeed()
 {
-    if (m_round_counter == 3)
+    char *text = SDL_GetClipboardText();
+    uint64_t seed;
+    if (parseSeed(text, seed))
     {
-        nextStage();
+        setSeed(seed);
     }
     else
     {
-        m_round_counter++;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Clipboard doesn't hold a seed: %s", text);
     }
+    SDL_free(text);
+}
 
-    int play_reward = play_counter / 2;
-    int discard_reward = discard_counter / 2;
-    int total = 1 + play_reward + discard_reward; // base + play + discard
-    game_page->play_reward->setText(std::string("$" + std::to_string(play_reward)).c_str());
-    game_page->discard_reward->setText(std::string("$" + std::to_string(discard_reward)).c_str());
-    game_page->total_reward->setText(std::string("$" + std::to_string(total)).c_str());
+void Game::randomizeSeed()
+{
+    m_seed_fixed = false;
+    updateSeedLabel();
+}
 
-    m_coin += total;
-    game_page->push(game_page->win_round_overlay);
+void Game::updateSeedLabel()
+{
+    std::string text = "Seed: ";
+    if (m_seed_fixed)
+    {
+        text += std::to_string(m_seed);
+    }
+    else if (m_seed != 0)
+    {
+        // keep the seed of the last run on screen so it can be reported
+        text += "random, last " + std::to_string(m_seed);
+    }
+    else
+    {
+        text += "random";
+    }
+    main_menu_page->seed_label->setText(text.c_str());
 }
 
-void Game::requestExit()
+RunSnapshot Game::snapshot() const
 {
-    m_exit = true;
+    RunSnapshot snapshot;
+    snapshot.game = rules.state;
+    return snapshot;
+}
+
+void Game::restore(const RunSnapshot &snapshot)
+{
+    current_page = game_page.get();
+    m_sequencer.cancelAll();
+    m_seed = snapshot.game.seed;
+    updateSeedLabel();
+    rules.restore(snapshot.game);
+    m_run_active = snapshot.game.phase != GamePhase::GAME_OVER;
+    compactJournal();
+    // saved halfway through scoring, pick the animation up where it was
+    GamePhase phase = rules.state.phase;
+    if (phase == GamePhase::SCORING || phase == GamePhase::SCORED)
+    {
+        m_sequencer.start(scoreHand());
+    }
+}
+
+bool Game::saveRun(const std::string &path) const
+{
+    return saveSnapshot(path, snapshot());
+}
+
+bool Game::loadRun(const std::string &path)
+{
+    RunSnapshot loaded;
+    if (!loadSnapshot(path, loaded))
+    {
+        return false;
+    }
+    restore(loaded);
+    return true;
+}
+
+void Game::journal(JournalAction action, uint64_t value)
+{
+    m_journal.append(JournalEntry{action, value});
+    if (m_journal.entryCount() >= journal_compact_entries)
+    {
+        compactJournal();
+    }
+}
+
+void Game::compactJournal()
+{
+    if (m_run_active)
+    {
+        m_journal.compact(snapshot());
+    }
+}
+
+void Game::disableAutosave()
+{
+    m_journal.close();
+}
+
+void Game::saveResume()
+{
+    // the journal is already on disk, a last checkpoint only makes the next launch replay less
+    if (m_run_active)
+    {
+        compactJournal();
+    }
+    m_journal.close();
+}
+
+void Game::continueRun()
+{
+    // left for the menu during this session, the run is still here
+    if (m_run_active)
+    {
+        current_page = game_page.get();
+        return;
+    }
+
+    RunSnapshot snapshot;
+    std::vector<JournalEntry> entries;
+    if (m_save_dir.empty() || !ActionJournal::recover(m_save_dir, snapshot, entries))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No run to continue");
+        updateContinueButton();
+        return;
+    }
+
+    // replay without a listener, only the final state gets drawn
+    GameRules replay;
+    replay.setTarotEffects(&m_tarot_effects);
+    replay.state = snapshot.game;
+    for (const JournalEntry &entry : entries)
+    {
+        applyJournalEntry(replay, entry);
+    }
+    snapshot.game = replay.state;
+    SDL_Log("Continuing run, %zu actions replayed onto the checkpoint", entries.size());
+    restore(snapshot);
+}
+
+void Game::updateContinueButton()
+{
+    bool has_autosave = !m_save_dir.empty() && ActionJournal::hasCheckpoint(m_save_dir);
+    main_menu_page->continue_button->setActive(m_run_active || has_autosave);
+}
+
+void Game::cycleScoringSpeed()
+{
+    m_scoring_speed = static_cast<ScoringSpeed>((static_cast<int>(m_scoring_speed) + 1) % 4);
+    updateSettingsLabels();
+}
+
+void Game::toggleClickToSkip()
+{
+    m_click_to_skip = !m_click_to_skip;
+    updateSettingsLabels();
+}
+
+void Game::updateSettingsLabels()
+{
+    const char *speed_names[] = {"Speed: 1x", "Speed: 2x", "Speed: 4x", "Speed: Instant"};
+    game_page->speed_button->setText(speed_names[static_cast<int>(m_scoring_speed)]);
+    main_menu_page->click_skip_button->setText(
+        m_click_to_skip ? "Click Skip: On" : "Click Skip: Off"
+    );
+}
+
+void Game::skipScoring()
+{
+    m_sequencer.cancelAll();
+    rules.finishScoring();
+    resolveHand();
+}
+
+void Game::resolveHand()
+{
+    if (rules.state.phase != GamePhase::SCORED) return;
+
+    rules.resolveHand();
+    journal(JournalAction::RESOLVE);
 }
 
 bool Game::exit()
@@ -194,9 +499,24 @@ bool Game::exit()
 
 void Game::updateComboWidget()
 {
-    game_page->combo_name->setText(card_manager.m_hand_name.c_str());
-    game_page->combo_chips->setText(std::to_string(m_current_hand_rank.chips).c_str());
-    game_page->combo_mult->setText(std::to_string(m_current_hand_rank.multiplier).c_str());
+    // only rewrite the labels whose value changed since the last call
+    HandType type = rules.state.card_manager.m_hand_type;
+    const HandRank &rank = rules.state.current_hand_rank;
+    if (!m_combo_shown || type != m_combo_type)
+    {
+        game_page->combo_name->setText(getHandName(type));
+    }
+    if (!m_combo_shown || rank.chips != m_combo_rank.chips)
+    {
+        game_page->combo_chips->setText(std::to_string(rank.chips).c_str());
+    }
+    if (!m_combo_shown || rank.multiplier != m_combo_rank.multiplier)
+    {
+        game_page->combo_mult->setText(std::to_string(rank.multiplier).c_str());
+    }
+    m_combo_shown = true;
+    m_combo_type = type;
+    m_combo_rank = rank;
 }
 
 void Game::hidePlayedCardsWidget()
@@ -209,111 +529,202 @@ void Game::hidePlayedCardsWidget()
     }
 }
 
+void Game::hidePlayedScores()
+{
+    for (auto played_card : game_page->played_card)
+    {
+        played_card->setRenderScore(false);
+    }
+    for (auto tarot : game_page->tarot_active)
+    {
+        tarot->setRenderScore(false);
+    }
+}
+
+void Game::updateTarotsWidget()
+{
+    const TarotState &tarots = rules.state.tarots;
+    for (int i = 0; i < game_page->tarot_active.size(); i++)
+    {
+        auto tarot = game_page->tarot_active[i];
+        if (i < tarots.held.size())
+        {
+            tarot->setTarot(&tarot_manager.getTarot(tarots.held[i]));
+            tarot->setSelected(i == m_selected_tarot);
+            tarot->clickLeave();
+            tarot->setActive(true);
+        }
+        else
+        {
+            tarot->resetPosition();
+            tarot->setTarot(nullptr);
+            tarot->setActive(false);
+        }
+    }
+    std::string description;
+    if (m_selected_tarot >= 0)
+    {
+        description = tarot_manager.getTarot(tarots.held[m_selected_tarot]).description;
+    }
+    game_page->tarot_description->setText(description.c_str());
+    game_page->tarot_sell_button->setActive(m_selected_tarot >= 0);
+}
+
+void Game::updateOfferWidget()
+{
+    const GameState &state = rules.state;
+    bool can_take = state.coin >= tarot_price && !state.tarots.held.full();
+    for (int i = 0; i < game_page->tarot_offer.size(); i++)
+    {
+        auto offer = game_page->tarot_offer[i];
+        if (i < state.tarots.offered.size())
+        {
+            offer->setTarot(&tarot_manager.getTarot(state.tarots.offered[i]));
+            offer->setVisible(true);
+            offer->setActive(can_take);
+        }
+        else
+        {
+            offer->setVisible(false);
+        }
+    }
+    std::string text = "Take a tarot for $" + std::to_string(tarot_price);
+    if (state.tarots.held.full())
+    {
+        text = "No room for another tarot";
+    }
+    game_page->tarot_offer_label->setText(text.c_str());
+}
+
+void Game::selectTarot(int index)
+{
+    m_selected_tarot = m_selected_tarot == index ? -1 : index;
+    updateTarotsWidget();
+}
+
+void Game::takeTarot(int index)
+{
+    if (rules.takeTarot(index))
+    {
+        journal(JournalAction::TAKE_TAROT, index);
+    }
+}
+
+void Game::sellSelectedTarot()
+{
+    // selling clears the selection, keep the index for the journal
+    int index = m_selected_tarot;
+    if (index >= 0 && rules.sellTarot(index))
+    {
+        journal(JournalAction::SELL_TAROT, index);
+    }
+}
+
 void Game::updatePlayedCardsWidget()
 {
-    for (int i = 0; i < card_manager.m_played_cards.size(); i++)
+    const CardManager &cards = rules.state.card_manager;
+    for (int i = 0; i < cards.m_played_cards.size(); i++)
     {
         auto played_card = game_page->played_card[i];
         played_card->setVisible(true);
-        played_card->setCard(card_manager.m_played_cards[i].get());
+        played_card->setCard(&getCard(cards.m_played_cards[i]));
     }
 }
 
-void Game::selectCard(int index)
+void Game::updateCountersWidget()
 {
-    card_manager.selectCard(index);
-    m_current_hand_rank = card_manager.hand_ranks[card_manager.m_hand_name];
-    updateComboWidget();
+    int play_counter = rules.state.play_counter;
+    int discard_counter = rules.state.discard_counter;
+    game_page->play_counter->setText(std::string("Play: " + std::to_string(play_counter)).c_str());
+    game_page->play_counter->setActive(play_counter > 0);
+    game_page->discard_counter->setText(
+        std::string("Discard: " + std::to_string(discard_counter)).c_str()
+    );
+    game_page->discard_counter->setActive(discard_counter > 0);
 }
 
-void Game::playHandSelectedCards()
+void Game::updateActionButtons()
 {
-    if (play_counter <= 0 || card_manager.count_selected_card == 0) return;
-    play_counter--;
-    card_manager.playSelectedCards();
-    updatePlayedCardsWidget();
-    game_page->play_counter->setText(std::string("Play: " + std::to_string(play_counter)).c_str());
-    if (play_counter == 0)
+    // cards and buttons only take input while the player is picking a hand
+    bool selecting = rules.state.phase == GamePhase::SELECTING;
+    game_page->play_button->setActive(selecting);
+    game_page->discard_button->setActive(selecting);
+    game_page->hint_button->setActive(selecting);
+    for (auto hand_card : game_page->hand_card)
     {
-        game_page->play_counter->setActive(false);
+        hand_card->setActive(selecting);
     }
-    last_tick = SDL_GetTicks();
-    state = State::GAME_CALCULATING;
-    last_card_index = 0;
-    auto *card_rank = &card_manager.hand_ranks[card_manager.m_hand_name];
-    card_rank->used++;
-    card_rank->chips += card_rank->used % 3 == 0 ? 10 : 0;
-    card_rank->multiplier += card_rank->used % 3 == 0 ? 1 : 0;
+}
 
-    m_current_hand_rank = *card_rank;
+void Game::selectCard(int index)
+{
+    if (rules.state.phase != GamePhase::SELECTING) return;
+
+    rules.selectCard(index);
+    journal(JournalAction::SELECT, index);
+}
+
+void Game::suggestBestPlay()
+{
+    BestPlay best = rules.state.card_manager.findBestPlay();
     for (int i = 0; i < game_page->hand_card.size(); i++)
     {
-        auto hand_card = game_page->hand_card[i];
-        if (i < card_manager.m_hand_cards.size())
-        {
-            hand_card->setActive(false);
-        }
+        game_page->hand_card[i]->setSuggested(best.mask & (uint64_t(1) << i));
+    }
+}
+
+void Game::playHandSelectedCards()
+{
+    if (!rules.playSelectedCards()) return;
+
+    journal(JournalAction::PLAY);
+    if (m_scoring_speed == ScoringSpeed::INSTANT)
+    {
+        skipScoring();
+    }
+    else
+    {
+        m_sequencer.start(scoreHand());
     }
-    game_page->play_button->setActive(false);
-    game_page->discard_button->setActive(false);
-    updateHandCardsWidget();
 }
 
 void Game::discardHandSelectedCards()
 {
-    if (discard_counter <= 0 || card_manager.count_selected_card == 0) return;
-    discard_counter--;
-    card_manager.deleteSelectedCards();
-    updateHandCardsWidget();
-    game_page->discard_counter->setText(
-        std::string("Discard: " + std::to_string(discard_counter)).c_str()
-    );
-    if (discard_counter == 0)
+    if (rules.discardSelectedCards())
     {
-        game_page->discard_counter->setActive(false);
+        journal(JournalAction::DISCARD);
     }
 }
 
 void Game::updateInfoRound()
 {
-    game_page->round_label_counter->setText(std::to_string(m_round_counter).c_str());
-    game_page->stage_label_counter->setText(std::to_string(m_stage_counter).c_str());
-    game_page->target_score_label->setText(std::to_string(m_target_score).c_str());
-    game_page->score_label->setText(std::to_string(m_score).c_str());
-    game_page->coin_label->setText(std::to_string(m_coin).c_str());
+    const GameState &state = rules.state;
+    game_page->round_label_counter->setText(std::to_string(state.round_counter).c_str());
+    game_page->stage_label_counter->setText(std::to_string(state.stage_counter).c_str());
+    game_page->target_score_label->setText(std::to_string(state.target_score).c_str());
+    game_page->score_label->setText(std::to_string(state.score).c_str());
+    game_page->coin_label->setText(std::to_string(state.coin).c_str());
 }
 
 void Game::newRound()
 {
-    card_manager.m_played_cards.clear();
-    card_manager.m_hand_name = "High Card";
-    m_current_hand_rank = card_manager.hand_ranks[card_manager.m_hand_name];
-    m_score = 0;
-    m_target_score = m_target_score * getStageScoreMult(m_round_counter);
-    play_counter = 4;
-    discard_counter = 5;
-    updateComboWidget();
-    updateInfoRound();
-    game_page->play_button->setActive(true);
-    game_page->discard_button->setActive(true);
-    card_manager.getNewShowedCards();
-    updateHandCardsWidget();
-    hidePlayedCardsWidget();
-    game_page->play_counter->setText(std::string("Play: " + std::to_string(play_counter)).c_str());
-    game_page->discard_counter->setText(
-        std::string("Discard: " + std::to_string(discard_counter)).c_str()
-    );
+    rules.newRound();
+    journal(JournalAction::NEW_ROUND);
 }
 
 void Game::newGame()
 {
-    card_manager.m_hand_cards.clear();
-    m_stage_counter = 1;
-    m_round_counter = 1;
-    m_target_score = 200;
-    m_score = 0;
-    m_current_hand_rank = {0, 1};
-    m_coin = 0;
-    discard_counter = 4;
-    play_counter = 5;
+    if (m_next_seed)
+    {
+        m_seed = *m_next_seed;
+        m_next_seed.reset();
+    }
+    else if (!m_seed_fixed)
+    {
+        m_seed = randomSeed();
+    }
+    m_runs_started++;
+    SDL_Log("Starting run with seed %llu", static_cast<unsigned long long>(m_seed));
+    updateSeedLabel();
+    rules.newGame(m_seed);
 }
@@ -1,43 +1,79 @@
 #ifndef SRC_GAME_H
 #define SRC_GAME_H
 
-#include "SDL3/SDL_timer.h"
 #include "card.h"
+#include "gameclock.h"
+#include "gamestate.h"
+#include "journal.h"
 #include "pages.h"
+#include "savegame.h"
+#include "sequence.h"
 #include <memory>
+#include <optional>
+#include <string>
 
+// actions between two checkpoints of the autosave
+constexpr size_t journal_compact_entries = 64;
 
+// how fast a played hand is counted up, the result is the same at every speed
+enum class ScoringSpeed
+{
+    NORMAL,
+    FAST,
+    FASTER,
+    INSTANT
+};
 
-float getStageScoreMult(int round);
-
+// window side of the game, runs GameRules and keeps the pages in sync with its events
 class Game
 {
 private:
     bool m_exit = false;
-    int m_stage_counter = 1;
-    int m_round_counter = 1;
-    int m_target_score = 200;
-    int m_score = 0;
-    HandRank m_current_hand_rank = {0, 1};
-    int m_coin = 0;
-    int discard_counter = 4;
-    int play_counter = 5;
+    // what the combo labels currently show
+    bool m_combo_shown = false;
+    HandType m_combo_type = HandType::HIGH_CARD;
+    HandRank m_combo_rank = {0, 1};
     std::unique_ptr<MainMenu> main_menu_page;
     std::unique_ptr<GamePage> game_page;
     Pages *current_page;
-    unsigned int last_tick = 0;
-    int last_card_index = 0;
+    Sequencer m_sequencer; // timed sequences, resumed by the clock
+    ScoringSpeed m_scoring_speed = ScoringSpeed::NORMAL;
+    bool m_click_to_skip = true;
+    // a new seed is rolled for each game unless the player picked one
+    bool m_seed_fixed = false;
+    uint64_t m_seed = 0;
+    std::optional<uint64_t> m_next_seed; // forced for the next game only, by replays
+    uint32_t m_runs_started = 0;
+    bool m_run_active = false; // started or continued and not over yet
+    std::string m_save_dir;
+    ActionJournal m_journal; // autosave of the current run
+    TarotEffects m_tarot_effects;
+    int m_selected_tarot = -1; // held tarot picked for selling
+
+    void onGameEvent(const GameEvent &event);
+
+    // one fixed clock step of game time
+    void step();
 
-    enum class State
-    {
-        MAIN_MENU,
-        GAME,
-        GAME_CALCULATING,
-        GAME_SCORING
-    } state;
+    // scoring delays shortened by the speed setting
+    uint32_t scoringDelay(uint32_t ms) const;
+
+    // play the score trace back and resolve the hand
+    Sequence scoreHand();
+
+    // resolve a scored hand, from the scoring sequence or a skip
+    void resolveHand();
+
+    void journal(JournalAction action, uint64_t value = 0);
+
+    // a checkpoint of the run, the journal starts over after it
+    void compactJournal();
 
 public:
-    CardManager card_manager;
+    GameRules rules;
+    TarotManager tarot_manager;
+    // drives every timed transition, tests can switch it to virtual time
+    GameClock clock;
 
     Game();
 
@@ -49,15 +85,65 @@ public:
 
     void render(SDL_Renderer *renderer);
 
+    // real time since the last frame, turned into fixed steps by the clock
     void update(float dt);
 
     void registerMouseEvents(SDL_Event *event);
 
-    void nextRound();
+    void requestExit();
 
-    void nextStage();
+    // play every following game with this seed
+    void setSeed(uint64_t seed);
 
-    void requestExit();
+    uint64_t getSeed() const;
+
+    bool isSeedFixed() const;
+
+    // start the next game with this seed whatever the seed setting is, for replays
+    void setNextRunSeed(uint64_t seed);
+
+    // games started so far, a recorder notes the seed whenever this changes
+    uint32_t getRunsStarted() const;
+
+    // read a seed from the clipboard, for replaying a reported run
+    void pasteSeed();
+
+    // go back to a new seed for every game
+    void randomizeSeed();
+
+    void updateSeedLabel();
+
+    // the run as plain data and back, for save files
+    RunSnapshot snapshot() const;
+
+    // carry on from a snapshot on the game page
+    void restore(const RunSnapshot &snapshot);
+
+    bool saveRun(const std::string &path) const;
+
+    // false if there is no save of this version at path
+    bool loadRun(const std::string &path);
+
+    // every action is journaled as it happens, this only leaves a last checkpoint on quit.
+    // a run left before it ended, or cut short by a crash, is offered as Continue on launch.
+    void saveResume();
+
+    // for replays and loaded scenarios, they shouldn't replace the player's run
+    void disableAutosave();
+
+    void continueRun();
+
+    void updateContinueButton();
+
+    // 1x, 2x, 4x, instant and around again
+    void cycleScoringSpeed();
+
+    void toggleClickToSkip();
+
+    void updateSettingsLabels();
+
+    // drop the scoring animation and resolve the hand right away
+    void skipScoring();
 
     void updateComboWidget();
 
@@ -65,10 +151,30 @@ public:
 
     void hidePlayedCardsWidget();
 
+    void hidePlayedScores();
+
+    void updateTarotsWidget();
+
+    // the tarots offered after a round won and what they cost
+    void updateOfferWidget();
+
+    void selectTarot(int index);
+
+    void takeTarot(int index);
+
+    void sellSelectedTarot();
+
     void updatePlayedCardsWidget();
 
+    void updateCountersWidget();
+
+    void updateActionButtons();
+
     void selectCard(int index);
 
+    // highlight the best play in hand
+    void suggestBestPlay();
+
     void playHandSelectedCards();
 
     void discardHandSelectedCards();
@@ -0,0 +1,61 @@
+#include "gameclock.h"
+#include <algorithm>
+
+int GameClock::advance(float real_seconds)
+{
+    if (m_paused)
+    {
+        return 0;
+    }
+    if (!m_virtual)
+    {
+        m_pending += real_seconds * 1000.0 * m_speed;
+        m_pending = std::min(m_pending, max_catch_up_ms * m_speed);
+    }
+
+    int steps = static_cast<int>(m_pending / step_ms);
+    m_pending -= static_cast<double>(steps) * step_ms;
+    m_now += static_cast<uint64_t>(steps) * step_ms;
+    return steps;
+}
+
+void GameClock::advanceBy(uint64_t ms)
+{
+    m_pending += static_cast<double>(ms);
+}
+
+uint64_t GameClock::now() const
+{
+    return m_now;
+}
+
+void GameClock::setPaused(bool paused)
+{
+    m_paused = paused;
+}
+
+bool GameClock::isPaused() const
+{
+    return m_paused;
+}
+
+void GameClock::setSpeed(float speed)
+{
+    m_speed = std::max(speed, 0.0f);
+}
+
+float GameClock::getSpeed() const
+{
+    return m_speed;
+}
+
+void GameClock::setVirtual(bool virtual_time)
+{
+    m_virtual = virtual_time;
+    m_pending = 0;
+}
+
+bool GameClock::isVirtual() const
+{
+    return m_virtual;
+}
@@ -0,0 +1,45 @@
+#ifndef SRC_GAMECLOCK_H
+#define SRC_GAMECLOCK_H
+
+// game time, handed out in fixed steps so timed transitions don't depend on the frame rate.
+// real time only comes in through advance, so tests and replays can drive it themselves.
+
+#include <cstdint>
+
+class GameClock
+{
+private:
+    uint64_t m_now = 0;     // ms of game time handed out so far
+    double m_pending = 0;   // ms of game time not yet handed out as steps
+    float m_speed = 1.0f;
+    bool m_paused = false;
+    bool m_virtual = false;
+
+public:
+    static constexpr uint32_t step_ms = 10;
+    static constexpr float step_seconds = step_ms / 1000.0f;
+    // after a hitch only this much real time is caught up, the rest is dropped
+    static constexpr double max_catch_up_ms = 250;
+
+    // turn real time since the last frame into whole steps, call once per frame
+    int advance(float real_seconds);
+
+    // queue game time directly, the only way time moves in virtual mode
+    void advanceBy(uint64_t ms);
+
+    uint64_t now() const;
+
+    // nothing steps while paused, not even widget click delays
+    void setPaused(bool paused);
+    bool isPaused() const;
+
+    // game time per real time, 2 runs everything twice as fast
+    void setSpeed(float speed);
+    float getSpeed() const;
+
+    // ignore real time completely, for tests and replays
+    void setVirtual(bool virtual_time);
+    bool isVirtual() const;
+};
+
+#endif // SRC_GAMECLOCK_H
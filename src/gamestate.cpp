@@ -0,0 +1,419 @@
+#include "gamestate.h"
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+float getStageScoreMult(int stage)
+{
+    switch (stage)
+    {
+        case 1:
+            return 1.0f;
+        case 2:
+            return 1.12f;
+        case 3:
+            return 1.32f;
+        default:
+            return 1.0f;
+    }
+}
+
+namespace
+{
+
+bool sameTarots(
+    const FixedList<TarotId, max_hand_tarots> &a,
+    const FixedList<TarotId, max_hand_tarots> &b
+)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+void addStep(ScoreTrace &trace, int card, int tarot, int chips, int mult, int times = 1)
+{
+    trace.result.chips += chips;
+    trace.result.multiplier += mult;
+    if (trace.steps.full())
+    {
+        // can't happen with the step bound, but never lose score to it
+        ScoreStep &last = trace.steps[trace.steps.size() - 1];
+        last.chips += chips;
+        last.mult += mult;
+        return;
+    }
+    ScoreStep step;
+    step.card = static_cast<int8_t>(card);
+    step.tarot = static_cast<int8_t>(tarot);
+    step.chips = chips;
+    step.mult = mult;
+    step.times = times;
+    trace.steps.push_back(step);
+}
+
+} // namespace
+
+ScoreTrace traceScoring(
+    HandRank base,
+    HandType type,
+    const CardList<max_play_cards> &played,
+    const TarotPipeline *pipeline
+)
+{
+    ScoreTrace trace;
+    trace.base = base;
+    trace.result = base;
+    int count = static_cast<int>(played.size());
+
+    // stages in order: hand chips, card chips, additive mult, then the multipliers
+    StageDelta hand;
+    if (pipeline && count > 0)
+    {
+        hand = pipeline->handDelta(type, count);
+    }
+    if (hand.chips != 0 || hand.mult != 0)
+    {
+        addStep(trace, -1, hand.tarot, hand.chips, hand.mult);
+    }
+
+    int times = hand.times;
+    int times_tarot = hand.times_tarot;
+    for (size_t i = 0; i < played.size(); i++)
+    {
+        StageDelta delta;
+        if (pipeline)
+        {
+            delta = pipeline->cardDelta(played[i], type, count);
+        }
+        // a retrigger scores the card and its modifiers once more
+        for (int pass = 0; pass < (delta.retrigger ? 2 : 1); pass++)
+        {
+            addStep(trace, i, -1, getCardChips(cardRank(played[i])), 0);
+            if (delta.chips != 0 || delta.mult != 0)
+            {
+                addStep(trace, i, delta.tarot, delta.chips, delta.mult);
+            }
+            times *= delta.times;
+            if (times_tarot < 0)
+            {
+                times_tarot = delta.times_tarot;
+            }
+        }
+    }
+
+    if (times != 1)
+    {
+        addStep(trace, -1, times_tarot, 0, trace.result.multiplier * (times - 1), times);
+    }
+
+    trace.score = trace.result.chips * trace.result.multiplier;
+    return trace;
+}
+
+void GameRules::emit(GameEventType type, int index)
+{
+    if (m_callback)
+    {
+        m_callback(GameEvent{type, index});
+    }
+}
+
+void GameRules::setPhase(GamePhase phase)
+{
+    state.phase = phase;
+    emit(GameEventType::PHASE_CHANGED);
+}
+
+void GameRules::onEvent(std::function<void(const GameEvent &)> callback)
+{
+    m_callback = std::move(callback);
+}
+
+void GameRules::setTarotEffects(const TarotEffects *effects)
+{
+    m_effects = effects;
+}
+
+const TarotPipeline *GameRules::tarotPipeline()
+{
+    if (!m_effects) return nullptr;
+
+    if (m_pipeline.effects != m_effects || !sameTarots(m_pipeline.held, state.tarots.held))
+    {
+        compileTarotPipeline(*m_effects, state.tarots.held, m_pipeline);
+    }
+    return &m_pipeline;
+}
+
+const AliasTable<TarotId, tarot_count> &GameRules::offerTable()
+{
+    const auto &held = state.tarots.held;
+    if (m_offer_built && m_offer_effects == m_effects && sameTarots(m_offer_held, held))
+    {
+        return m_offer_table;
+    }
+
+    // every tarot not held, weighted by its rarity, all common without effects
+    std::array<TarotId, tarot_count> pool;
+    std::array<uint32_t, tarot_count> weights;
+    size_t size = 0;
+    for (int id = 0; id < tarot_count; id++)
+    {
+        if (std::find(held.begin(), held.end(), id) != held.end()) continue;
+
+        TarotRarity rarity = m_effects ? m_effects->rarities[id] : TarotRarity::COMMON;
+        pool[size] = id;
+        weights[size] = rarity_weights[static_cast<int>(rarity)];
+        size++;
+    }
+    m_offer_table.build(pool.data(), weights.data(), size);
+    m_offer_held = held;
+    m_offer_effects = m_effects;
+    m_offer_built = true;
+    return m_offer_table;
+}
+
+void GameRules::newGame(uint64_t seed)
+{
+    // start from scratch so a run only depends on its seed
+    state = GameState();
+    state.seed = seed;
+    state.card_manager.rng.seed(seed, RandomStream::DECK);
+    state.tarots.rng.seed(seed, RandomStream::TAROT);
+    emit(GameEventType::RESET);
+}
+
+void GameRules::restore(const GameState &saved)
+{
+    state = saved;
+    emit(GameEventType::RESET);
+    emit(GameEventType::PLAYED_CHANGED);
+    for (size_t i = 0; i < state.card_manager.m_hand_cards.size(); i++)
+    {
+        emit(GameEventType::CARD_SELECTED, static_cast<int>(i));
+    }
+    emit(GameEventType::TAROTS_CHANGED);
+    emit(GameEventType::PHASE_CHANGED);
+}
+
+void GameRules::newRound()
+{
+    CardManager &cards = state.card_manager;
+    cards.m_played_cards.clear();
+    cards.m_hand_type = HandType::HIGH_CARD;
+    state.current_hand_rank = cards.getHandRank(cards.m_hand_type);
+    state.score = 0;
+    state.target_score = state.target_score * getStageScoreMult(state.round_counter);
+    state.play_counter = 4;
+    state.discard_counter = 5;
+    state.phase = GamePhase::SELECTING;
+    state.tarots.offered.clear();
+    cards.getNewShowedCards();
+    emit(GameEventType::RESET);
+}
+
+void GameRules::nextStage()
+{
+    state.stage_counter++;
+    state.card_manager.resetCards();
+
+    state.round_counter = 1;
+    state.target_score += 200;
+}
+
+void GameRules::nextRound()
+{
+    if (state.round_counter == 3)
+    {
+        nextStage();
+    }
+    else
+    {
+        state.round_counter++;
+    }
+
+    RoundReward &reward = state.reward;
+    reward.play = state.play_counter / 2;
+    reward.discard = state.discard_counter / 2;
+    reward.total = 1 + reward.play + reward.discard;
+    state.coin += reward.total;
+    offerTarots();
+    emit(GameEventType::INFO_CHANGED);
+    setPhase(GamePhase::ROUND_WON);
+}
+
+void GameRules::offerTarots()
+{
+    // weighted draws, one again when it's offered already
+    TarotState &tarots = state.tarots;
+    const AliasTable<TarotId, tarot_count> &table = offerTable();
+    tarots.offered.clear();
+    size_t offers = std::min<size_t>(tarots.offered.capacity(), table.count);
+    while (tarots.offered.size() < offers && !table.empty())
+    {
+        TarotId id = table.sample(tarots.rng);
+        if (std::find(tarots.offered.begin(), tarots.offered.end(), id) == tarots.offered.end())
+        {
+            tarots.offered.push_back(id);
+        }
+    }
+    emit(GameEventType::TAROTS_CHANGED);
+}
+
+void GameRules::selectCard(size_t index)
+{
+    if (state.phase != GamePhase::SELECTING) return;
+
+    CardManager &cards = state.card_manager;
+    cards.selectCard(index);
+    state.current_hand_rank = cards.getHandRank(cards.m_hand_type);
+    emit(GameEventType::CARD_SELECTED, index);
+    emit(GameEventType::COMBO_CHANGED);
+}
+
+bool GameRules::playSelectedCards()
+{
+    CardManager &cards = state.card_manager;
+    if (state.phase != GamePhase::SELECTING) return false;
+    if (state.play_counter <= 0 || cards.count_selected_card == 0) return false;
+
+    state.play_counter--;
+    cards.playSelectedCards();
+    state.score_trace = traceScoring(
+        cards.useHandRank(cards.m_hand_type),
+        cards.m_hand_type,
+        cards.m_played_cards,
+        tarotPipeline()
+    );
+    state.trace_cursor = 0;
+    state.current_hand_rank = state.score_trace.base;
+    emit(GameEventType::PLAYED_CHANGED);
+    emit(GameEventType::HAND_CHANGED);
+    emit(GameEventType::COUNTERS_CHANGED);
+    emit(GameEventType::COMBO_CHANGED);
+    setPhase(GamePhase::SCORING);
+    return true;
+}
+
+bool GameRules::discardSelectedCards()
+{
+    CardManager &cards = state.card_manager;
+    if (state.phase != GamePhase::SELECTING) return false;
+    if (state.discard_counter <= 0 || cards.count_selected_card == 0) return false;
+
+    state.discard_counter--;
+    cards.deleteSelectedCards();
+    emit(GameEventType::HAND_CHANGED);
+    emit(GameEventType::COUNTERS_CHANGED);
+    return true;
+}
+
+void GameRules::scoreNextStep()
+{
+    if (state.phase != GamePhase::SCORING) return;
+
+    const ScoreTrace &trace = state.score_trace;
+    if (state.trace_cursor < static_cast<int>(trace.steps.size()))
+    {
+        const ScoreStep &step = trace.steps[state.trace_cursor];
+        state.current_hand_rank.chips += step.chips;
+        state.current_hand_rank.multiplier += step.mult;
+        state.trace_cursor++;
+        if (step.card >= 0)
+        {
+            emit(GameEventType::CARD_SCORED, step.card);
+        }
+        if (step.tarot >= 0)
+        {
+            emit(GameEventType::TAROT_SCORED, step.tarot);
+        }
+        emit(GameEventType::COMBO_CHANGED);
+    }
+    else
+    {
+        state.score += trace.score;
+        emit(GameEventType::INFO_CHANGED);
+        setPhase(GamePhase::SCORED);
+    }
+}
+
+void GameRules::finishScoring()
+{
+    if (state.phase != GamePhase::SCORING) return;
+
+    state.current_hand_rank = state.score_trace.result;
+    state.trace_cursor = state.score_trace.steps.size();
+    emit(GameEventType::COMBO_CHANGED);
+    scoreNextStep();
+}
+
+void GameRules::resolveHand()
+{
+    if (state.phase != GamePhase::SCORED) return;
+
+    if (state.score >= state.target_score)
+    {
+        nextRound();
+        return;
+    }
+
+    CardManager &cards = state.card_manager;
+    cards.m_played_cards.clear();
+    state.current_hand_rank = {0, 1};
+    cards.m_hand_type = HandType::HIGH_CARD;
+    cards.getNewShowedCards();
+    emit(GameEventType::COMBO_CHANGED);
+    emit(GameEventType::INFO_CHANGED);
+    emit(GameEventType::HAND_CHANGED);
+    emit(GameEventType::PLAYED_CHANGED);
+    emit(GameEventType::COUNTERS_CHANGED);
+    setPhase(state.play_counter == 0 ? GamePhase::GAME_OVER : GamePhase::SELECTING);
+}
+
+bool GameRules::takeTarot(size_t index)
+{
+    TarotState &tarots = state.tarots;
+    if (state.phase != GamePhase::ROUND_WON) return false;
+    if (index >= tarots.offered.size() || tarots.held.full()) return false;
+    if (state.coin < tarot_price) return false;
+
+    state.coin -= tarot_price;
+    tarots.held.push_back(tarots.offered[index]);
+    tarots.offered.erase(index);
+    emit(GameEventType::TAROTS_CHANGED);
+    emit(GameEventType::INFO_CHANGED);
+    return true;
+}
+
+bool GameRules::sellTarot(size_t index)
+{
+    TarotState &tarots = state.tarots;
+    if (state.phase != GamePhase::SELECTING && state.phase != GamePhase::ROUND_WON) return false;
+    if (index >= tarots.held.size()) return false;
+
+    state.coin += tarot_sell_price;
+    tarots.held.erase(index);
+    emit(GameEventType::TAROTS_CHANGED);
+    emit(GameEventType::INFO_CHANGED);
+    return true;
+}
+
+bool GameRules::playHand()
+{
+    if (!playSelectedCards()) return false;
+
+    finishScoring();
+    resolveHand();
+    return true;
+}
+
+int GameRules::previewScore(const BestPlay &play)
+{
+    CardManager &cards = state.card_manager;
+    CardList<max_play_cards> played;
+    for (uint64_t bits = play.mask; bits != 0 && !played.full(); bits &= bits - 1)
+    {
+        played.push_back(cards.m_hand_cards[std::countr_zero(bits)]);
+    }
+    HandRank base = cards.previewHandRank(play.type);
+    return traceScoring(base, play.type, played, tarotPipeline()).score;
+}
@@ -0,0 +1,182 @@
+#ifndef SRC_GAMESTATE_H
+#define SRC_GAMESTATE_H
+
+// the rules of a run without SDL, so whole games can run headless in tools.
+// nothing here touches widgets, the window side listens to the events and updates the pages.
+
+#include "cardmanager.h"
+#include "handevaluator.h"
+#include "random.h"
+#include "scorepipeline.h"
+#include "tarot.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+float getStageScoreMult(int round);
+
+enum class GamePhase
+{
+    SELECTING, // waiting for a play or a discard
+    SCORING,   // the score trace plays back one step at a time
+    SCORED,    // the hand's score is in, waiting to resolve it
+    ROUND_WON, // waiting for the next round
+    GAME_OVER
+};
+
+struct RoundReward
+{
+    int play = 0;
+    int discard = 0;
+    int total = 0; // base + play + discard
+};
+
+// the tarot side of a run, the offer after a round won and the tarots held
+struct TarotState
+{
+    FixedList<TarotId, max_showed_tarots> offered;
+    FixedList<TarotId, max_hand_tarots> held;
+    Pcg32 rng; // tarot stream, so buying tarots never changes the cards dealt
+};
+
+// one thing that adds to a hand's score, in the order the animation shows it
+struct ScoreStep
+{
+    int8_t card = -1;  // played card index, -1 when no card shows it
+    int8_t tarot = -1; // held tarot shown with it, the first of those merged into it
+    int32_t chips = 0;
+    int32_t mult = 0;
+    int32_t times = 1; // what the multiplier step multiplies by, mult is what that adds
+};
+
+// the hand stage, a card and its modifiers twice for a retrigger, then the multipliers
+constexpr int max_score_steps = 1 + max_play_cards * 2 * 2 + 1;
+
+// the whole scoring of a played hand, worked out in one pass when it's played.
+// the animation only plays the steps back, so the score never depends on frame timing.
+struct ScoreTrace
+{
+    HandRank base = {0, 1}; // chips and mult of the hand type
+    FixedList<ScoreStep, max_score_steps> steps;
+    HandRank result = {0, 1}; // base plus every step
+    int score = 0;            // result chips times mult
+};
+
+// pipeline may be null, then the tarots held do nothing
+ScoreTrace traceScoring(
+    HandRank base,
+    HandType type,
+    const CardList<max_play_cards> &played,
+    const TarotPipeline *pipeline
+);
+
+// everything about a run, plain data so it can be copied and stored as is
+struct GameState
+{
+    uint64_t seed = 0;
+    GamePhase phase = GamePhase::SELECTING;
+    int stage_counter = 1;
+    int round_counter = 1;
+    int target_score = 200;
+    int score = 0;
+    int coin = 0;
+    int play_counter = 5;
+    int discard_counter = 4;
+    // what the combo shows, counts up step by step while scoring
+    HandRank current_hand_rank = {0, 1};
+    ScoreTrace score_trace; // of the hand being scored
+    int trace_cursor = 0;   // steps of the trace already played back
+    RoundReward reward; // of the last round won
+    CardManager card_manager;
+    TarotState tarots;
+};
+
+static_assert(std::is_trivially_copyable_v<GameState>);
+
+enum class GameEventType
+{
+    RESET,            // a new game or round, everything changed
+    HAND_CHANGED,     // cards were dealt, played or discarded
+    CARD_SELECTED,    // index is the hand card that was toggled
+    PLAYED_CHANGED,   // cards were played or cleared from the table
+    COMBO_CHANGED,    // hand type or the current chips and mult
+    INFO_CHANGED,     // stage, round, target score, score or coins
+    COUNTERS_CHANGED, // plays or discards left
+    CARD_SCORED,      // index is the played card of the step just played back
+    TAROT_SCORED,     // index is the held tarot of the step just played back
+    TAROTS_CHANGED,   // tarots offered or held
+    PHASE_CHANGED
+};
+
+struct GameEvent
+{
+    GameEventType type;
+    int index = -1;
+};
+
+class GameRules
+{
+private:
+    std::function<void(const GameEvent &)> m_callback;
+    const TarotEffects *m_effects = nullptr;
+    TarotPipeline m_pipeline; // of the tarots held, compiled again when they change
+    // offer odds of the tarots not held, built again when they change
+    AliasTable<TarotId, tarot_count> m_offer_table;
+    FixedList<TarotId, max_hand_tarots> m_offer_held;
+    const TarotEffects *m_offer_effects = nullptr;
+    bool m_offer_built = false;
+
+    // null without effects
+    const TarotPipeline *tarotPipeline();
+
+    const AliasTable<TarotId, tarot_count> &offerTable();
+
+    void emit(GameEventType type, int index = -1);
+    void setPhase(GamePhase phase);
+    void nextStage();
+    void nextRound();
+    void offerTarots();
+
+public:
+    GameState state;
+
+    void onEvent(std::function<void(const GameEvent &)> callback);
+
+    // loaded once and shared, without them tarots can be held but do nothing
+    void setTarotEffects(const TarotEffects *effects);
+
+    void newGame(uint64_t seed);
+
+    // carry on from a saved state, the listener redraws everything
+    void restore(const GameState &saved);
+    void newRound();
+
+    void selectCard(size_t index);
+
+    // false when there is nothing selected or no plays left
+    bool playSelectedCards();
+    bool discardSelectedCards();
+
+    // play back the next step of the trace, moves on to SCORED after the last one
+    void scoreNextStep();
+
+    // skip to the end of the trace, the result is the same as stepping through it
+    void finishScoring();
+
+    // win the round, deal for the next hand or end the game
+    void resolveHand();
+
+    // buy an offered tarot after a round won, false without the coins or room for it
+    bool takeTarot(size_t index);
+
+    bool sellTarot(size_t index);
+
+    // play the selection and resolve it right away, for headless runs
+    bool playHand();
+
+    // what the hand cards of a play would score with the tarots held, without playing them
+    int previewScore(const BestPlay &play);
+};
+
+#endif // SRC_GAMESTATE_H
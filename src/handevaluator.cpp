@@ -0,0 +1,528 @@
+#include "handevaluator.h"
+#include "handrules.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// a suit with 5 or more cards, adding 123 pushes any such byte into its top bit
+constexpr bool hasFlush(uint32_t suit_counts)
+{
+    return ((suit_counts + 0x7B7B7B7B) & 0x80808080) != 0;
+}
+
+// ================================  Lookup tables  ================================
+
+// hands without a repeated rank are indexed by their rank bits directly.
+// hands with a repeated rank are keyed by their packed rank counts (HandMask::rank_counts)
+// through a hash-and-displace perfect hash: the hash picks a bucket, the bucket's displacement
+// moves the key to a slot no other key uses.
+
+constexpr int rank_count = 13;
+constexpr int rank_bits_count = 1 << rank_count;
+constexpr int paired_table_size = 8192; // 6175 patterns with a repeated rank
+constexpr int paired_bucket_count = 2048;
+
+struct PairedEntry
+{
+    uint64_t key = 0;
+    HandValue value = 0;
+};
+
+struct HandTables
+{
+    std::array<HandValue, rank_bits_count> unique{};
+    std::array<HandValue, rank_bits_count> flush{};
+    std::array<uint16_t, paired_bucket_count> displacement{};
+    std::array<PairedEntry, paired_table_size> paired{};
+    uint64_t seed = 0;
+    bool complete = false;
+};
+
+constexpr uint64_t hashKey(uint64_t key, uint64_t seed)
+{
+    key ^= seed * 0x9E3779B97F4A7C15;
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCD;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53;
+    key ^= key >> 33;
+    return key;
+}
+
+constexpr int bucketOf(uint64_t hash)
+{
+    return (hash >> 48) % paired_bucket_count;
+}
+
+// keys in one bucket step through the table at different (odd) strides,
+// so some displacement separates them unless two keys hash exactly alike
+constexpr int slotOf(uint64_t hash, uint16_t displacement)
+{
+    uint32_t start = static_cast<uint32_t>(hash);
+    uint32_t stride = static_cast<uint32_t>(hash >> 24) | 1;
+    return (start + displacement * stride) & (paired_table_size - 1);
+}
+
+// hand value worked out from the packed rank counts alone, kept apart from the reference
+// predicates so the compile-time check below actually compares two implementations
+constexpr HandValue computeHandValue(uint64_t rank_counts, bool flush)
+{
+    int count = 0;
+    int pairs = 0;
+    int most = 0;
+    uint32_t rank_bits = 0;
+    // ranks of the single cards, pairs, trips and quads, high to low at 4 bits each
+    uint32_t groups[4] = {};
+    int group_sizes[4] = {};
+    for (int r = rank_count - 1; r >= 0; r--)
+    {
+        int n = (rank_counts >> (r * 4)) & 0xF;
+        if (n == 0) continue;
+        count += n;
+        pairs += n >= 2;
+        most = std::max(most, n);
+        rank_bits |= 1u << r;
+        groups[n - 1] = (groups[n - 1] << 4) | (r + 2);
+        group_sizes[n - 1]++;
+    }
+
+    // rank index of the top card of a straight, the ace playing low makes a five high straight
+    int straight_top = -1;
+    uint32_t runs = rank_bits & (rank_bits >> 1) & (rank_bits >> 2) & (rank_bits >> 3) &
+                    (rank_bits >> 4);
+    if (runs != 0) straight_top = std::bit_width(runs) + 3;
+    else if ((rank_bits & 0x100F) == 0x100F) straight_top = 3;
+    bool straight = straight_top >= 0;
+
+    HandType type = HandType::HIGH_CARD;
+    if (straight && flush) type = HandType::STRAIGHT_FLUSH;
+    else if (most >= 4) type = HandType::FOUR_OF_A_KIND;
+    else if (most >= 3 && pairs >= 2 && count >= 5) type = HandType::FULL_HOUSE;
+    else if (flush) type = HandType::FLUSH;
+    else if (straight) type = HandType::STRAIGHT;
+    else if (most >= 3) type = HandType::THREE_OF_A_KIND;
+    else if (pairs >= 2) type = HandType::TWO_PAIR;
+    else if (pairs >= 1) type = HandType::PAIR;
+
+    // straights only compare their top card, everything else compares ranks grouped by
+    // count (biggest group first) and then from high to low
+    HandValue tiebreak = 0;
+    if (straight)
+    {
+        tiebreak = static_cast<HandValue>(straight_top + 2) << 16;
+    }
+    else
+    {
+        int packed = 0;
+        for (int n = 3; n >= 0; n--)
+        {
+            tiebreak = (tiebreak << (group_sizes[n] * 4)) | groups[n];
+            packed += group_sizes[n];
+        }
+        tiebreak <<= 4 * (5 - packed);
+    }
+    return (static_cast<HandValue>(type) << hand_value_shift) | tiebreak;
+}
+
+// calls callback with the packed rank counts of every hand of 1 to 5 cards, at most 4 of a rank
+template <typename Callback> constexpr void forEachRankPattern(Callback callback)
+{
+    for (int size = 1; size <= 5; size++)
+    {
+        int pick[5] = {}; // rank of each card, never decreasing
+        while (true)
+        {
+            uint64_t rank_counts = 0;
+            for (int i = 0; i < size; i++)
+            {
+                rank_counts += uint64_t(1) << (pick[i] * 4);
+            }
+            // a rank past 4 cards would show up as bit 2 and bit 0 of its counter both set
+            bool valid = (rank_counts & (rank_counts >> 2) & 0x1111111111111) == 0;
+            if (valid) callback(rank_counts);
+
+            int i = size - 1;
+            while (i >= 0 && pick[i] == rank_count - 1) i--;
+            if (i < 0) break;
+            pick[i]++;
+            for (int j = i + 1; j < size; j++) pick[j] = pick[i];
+        }
+    }
+}
+
+// give every paired key its own slot, false if some bucket can't be placed with this seed
+constexpr bool placePairedKeys(
+    HandTables &tables,
+    const std::array<uint64_t, paired_table_size> &keys,
+    int key_count
+)
+{
+    // group the keys by bucket, hashing each key only once
+    std::array<int, paired_bucket_count + 1> start{};
+    std::array<uint64_t, paired_table_size> hashes{};
+    for (int i = 0; i < key_count; i++)
+    {
+        hashes[i] = hashKey(keys[i], tables.seed);
+        start[bucketOf(hashes[i]) + 1]++;
+    }
+    for (int b = 0; b < paired_bucket_count; b++)
+    {
+        start[b + 1] += start[b];
+    }
+    std::array<int, paired_table_size> grouped{}; // key indices
+    std::array<int, paired_bucket_count> fill{};
+    for (int i = 0; i < key_count; i++)
+    {
+        int bucket = bucketOf(hashes[i]);
+        grouped[start[bucket] + fill[bucket]++] = i;
+    }
+
+    // biggest buckets first while the table is still empty
+    std::array<int, paired_bucket_count> order{};
+    for (int b = 0; b < paired_bucket_count; b++)
+    {
+        order[b] = b;
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return start[a + 1] - start[a] > start[b + 1] - start[b];
+    });
+
+    std::array<bool, paired_table_size> used{};
+    for (int bucket : order)
+    {
+        int first = start[bucket];
+        int last = start[bucket + 1];
+        if (first == last) break;
+
+        int displacement = 0;
+        for (; displacement < 0x10000; displacement++)
+        {
+            int claimed = first;
+            for (; claimed < last; claimed++)
+            {
+                int slot = slotOf(hashes[grouped[claimed]], displacement);
+                if (used[slot]) break;
+                used[slot] = true;
+            }
+            if (claimed == last) break;
+
+            // give back the slots this attempt claimed
+            for (int i = first; i < claimed; i++)
+            {
+                used[slotOf(hashes[grouped[i]], displacement)] = false;
+            }
+        }
+        if (displacement == 0x10000) return false;
+
+        tables.displacement[bucket] = displacement;
+        for (int i = first; i < last; i++)
+        {
+            uint64_t key = keys[grouped[i]];
+            int slot = slotOf(hashes[grouped[i]], displacement);
+            tables.paired[slot] = {key, computeHandValue(key, false)};
+        }
+    }
+    return true;
+}
+
+constexpr HandTables buildHandTables()
+{
+    HandTables tables;
+
+    for (int bits = 0; bits < rank_bits_count; bits++)
+    {
+        if (std::popcount(static_cast<uint32_t>(bits)) > 5) continue;
+        uint64_t rank_counts = 0;
+        for (int r = 0; r < rank_count; r++)
+        {
+            rank_counts |= static_cast<uint64_t>((bits >> r) & 1) << (r * 4);
+        }
+        tables.unique[bits] = computeHandValue(rank_counts, false);
+        tables.flush[bits] = std::popcount(static_cast<uint32_t>(bits)) == 5
+                                 ? computeHandValue(rank_counts, true)
+                                 : tables.unique[bits];
+    }
+
+    std::array<uint64_t, paired_table_size> keys{};
+    int key_count = 0;
+    forEachRankPattern([&](uint64_t rank_counts) {
+        // some rank with 2 or more cards
+        if ((rank_counts & 0x6666666666666) != 0) keys[key_count++] = rank_counts;
+    });
+
+    for (int seed = 0; seed < 64 && !tables.complete; seed++)
+    {
+        tables.seed = seed;
+        tables.displacement = {};
+        tables.paired = {};
+        tables.complete = placePairedKeys(tables, keys, key_count);
+    }
+    return tables;
+}
+
+constexpr HandValue lookupIn(const HandTables &tables, const HandMask &hand)
+{
+    if (std::popcount(hand.rank_bits) == hand.count)
+    {
+        return hasFlush(hand.suit_counts) ? tables.flush[hand.rank_bits]
+                                          : tables.unique[hand.rank_bits];
+    }
+    uint64_t hash = hashKey(hand.rank_counts, tables.seed);
+    return tables.paired[slotOf(hash, tables.displacement[bucketOf(hash)])].value;
+}
+
+constexpr HandTables hand_tables = buildHandTables();
+
+static_assert(hand_tables.complete, "no seed gives a perfect hash for the paired hands");
+
+// compile-time test: every rank pattern of up to 5 cards, suited and unsuited, must get the
+// same hand type from the tables as from the reference predicates
+constexpr bool checkHandTables()
+{
+    bool ok = true;
+    forEachRankPattern([&](uint64_t rank_counts) {
+        for (int suited = 0; suited < 2; suited++)
+        {
+            // two cards of the same rank can't share a suit
+            if (suited && (rank_counts & 0x6666666666666) != 0) continue;
+
+            HandCounts counts;
+            HandMask mask;
+            int card = 0;
+            for (int r = 0; r < rank_count; r++)
+            {
+                int n = (rank_counts >> (r * 4)) & 0xF;
+                for (int i = 0; i < n; i++)
+                {
+                    // unsuited hands spread the suits so five cards never share one
+                    auto rank = static_cast<CardRank>(r + static_cast<int>(CardRank::TWO));
+                    auto suit = static_cast<CardSuits>(suited ? 0 : card % 4);
+                    counts.add(rank, suit);
+                    mask.add(rank, suit);
+                    card++;
+                }
+            }
+            ok &= getHandType(lookupIn(hand_tables, mask)) == hand_rules::classify(counts);
+        }
+    });
+    return ok;
+}
+
+static_assert(checkHandTables(), "hand lookup tables disagree with the reference predicates");
+} // namespace
+
+HandType evaluateHand(const HandMask &hand)
+{
+    // split every 4 bit rank counter into its bits, one bit per rank in each mask.
+    // a rank holds at most 4 cards so the counter never goes past bit 2.
+    constexpr uint64_t nibble_low = 0x1111111111111;
+    uint64_t bit0 = hand.rank_counts & nibble_low;
+    uint64_t bit1 = (hand.rank_counts >> 1) & nibble_low;
+    uint64_t bit2 = (hand.rank_counts >> 2) & nibble_low;
+
+    int pairs = std::popcount(bit1 | bit2);     // ranks with 2 or more cards
+    bool trips = (bit2 | (bit1 & bit0)) != 0;   // a rank with 3 or more cards
+    bool quads = bit2 != 0;                     // a rank with 4 cards
+
+    // five ranks in a row, or the ace playing low under A-2-3-4-5
+    constexpr uint16_t wheel = 0x100F;
+    uint16_t r = hand.rank_bits;
+    bool straight = (r & (r >> 1) & (r >> 2) & (r >> 3) & (r >> 4)) != 0 || (r & wheel) == wheel;
+
+    bool flush = hasFlush(hand.suit_counts);
+
+    int type = std::max({
+        (pairs >= 1) * static_cast<int>(HandType::PAIR),
+        (pairs >= 2) * static_cast<int>(HandType::TWO_PAIR),
+        trips * static_cast<int>(HandType::THREE_OF_A_KIND),
+        straight * static_cast<int>(HandType::STRAIGHT),
+        flush * static_cast<int>(HandType::FLUSH),
+        (trips && pairs >= 2 && hand.count >= 5) * static_cast<int>(HandType::FULL_HOUSE),
+        quads * static_cast<int>(HandType::FOUR_OF_A_KIND),
+        (straight && flush) * static_cast<int>(HandType::STRAIGHT_FLUSH),
+    });
+    return static_cast<HandType>(type);
+}
+
+HandValue lookupHand(const HandMask &hand)
+{
+    if (hand.count > 5)
+    {
+        return static_cast<HandValue>(evaluateHand(hand)) << hand_value_shift;
+    }
+    return lookupIn(hand_tables, hand);
+}
+
+// ================================  Batch evaluation  ================================
+
+namespace
+{
+// move bit i of a 13 bit rank set to bit 4 * i, lining it up with HandMask::rank_counts
+constexpr uint64_t spreadRanks(uint64_t bits)
+{
+    bits &= 0x1FFF;
+    bits = (bits | (bits << 24)) & 0x000000FF000000FF;
+    bits = (bits | (bits << 12)) & 0x000F000F000F000F;
+    bits = (bits | (bits << 6)) & 0x0303030303030303;
+    bits = (bits | (bits << 3)) & 0x1111111111111111;
+    return bits;
+}
+
+static_assert(spreadRanks(0x1FFF) == 0x1111111111111);
+static_assert(spreadRanks(0x1001) == 0x1000000000001);
+
+// card count and chip sum for every 13 bit suit mask, so unpacking a hand needs no popcount
+// instruction (the default x86-64 target has none)
+struct SuitInfo
+{
+    uint8_t count;
+    uint8_t chips;
+};
+
+constexpr std::array<SuitInfo, 1 << 13> buildSuitInfo()
+{
+    std::array<SuitInfo, 1 << 13> info{};
+    for (int bits = 0; bits < (1 << 13); bits++)
+    {
+        int count = 0;
+        int chips = 0;
+        for (int rank = 0; rank < 13; rank++)
+        {
+            if ((bits >> rank) & 1)
+            {
+                count++;
+                chips += getCardChips(static_cast<CardRank>(rank + 2));
+            }
+        }
+        info[bits] = {static_cast<uint8_t>(count), static_cast<uint8_t>(chips)};
+    }
+    return info;
+}
+
+constexpr std::array<SuitInfo, 1 << 13> suit_info = buildSuitInfo();
+
+// unpacks a card mask and sums its card chips in the same pass
+HandMask unpackHand(CardMask cards, int &chips)
+{
+    HandMask hand;
+    chips = 0;
+    int count = 0;
+    for (int suit = 0; suit < 4; suit++)
+    {
+        uint64_t suit_bits = (cards >> (suit * 13)) & 0x1FFF;
+        SuitInfo info = suit_info[suit_bits];
+        hand.rank_counts += spreadRanks(suit_bits);
+        hand.suit_counts |= static_cast<uint32_t>(info.count) << (suit * 8);
+        hand.rank_bits |= suit_bits;
+        count += info.count;
+        chips += info.chips;
+    }
+    hand.count = count;
+    return hand;
+}
+} // namespace
+
+HandMask toHandMask(CardMask cards)
+{
+    int chips;
+    return unpackHand(cards, chips);
+}
+
+void evaluateHands(
+    const CardMask *hands,
+    HandResult *results,
+    size_t count,
+    const std::array<HandRank, hand_type_count> &ranks
+)
+{
+    // blocks keep the unpacked hands in cache between the two passes
+    constexpr size_t block_size = 256;
+    uint64_t rank_counts[block_size];
+    uint32_t suit_counts[block_size];
+    uint16_t rank_bits[block_size];
+    uint8_t card_counts[block_size];
+    int chips[block_size];
+
+    for (size_t start = 0; start < count; start += block_size)
+    {
+        size_t n = std::min(block_size, count - start);
+
+        // unpack the whole block first, its table loads don't wait on the lookups below
+        for (size_t i = 0; i < n; i++)
+        {
+            HandMask hand = unpackHand(hands[start + i], chips[i]);
+            rank_counts[i] = hand.rank_counts;
+            suit_counts[i] = hand.suit_counts;
+            rank_bits[i] = hand.rank_bits;
+            card_counts[i] = hand.count;
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            HandMask hand;
+            hand.rank_counts = rank_counts[i];
+            hand.suit_counts = suit_counts[i];
+            hand.rank_bits = rank_bits[i];
+            hand.count = card_counts[i];
+
+            HandValue value = lookupHand(hand);
+            const HandRank &rank = ranks[static_cast<int>(getHandType(value))];
+            results[start + i] = {value, (rank.chips + chips[i]) * rank.multiplier};
+        }
+    }
+}
+
+void evaluateHandsParallel(
+    const CardMask *hands,
+    HandResult *results,
+    size_t count,
+    const std::array<HandRank, hand_type_count> &ranks,
+    unsigned threads
+)
+{
+#ifdef __EMSCRIPTEN__
+    // the web build has no threads
+    evaluateHands(hands, results, count, ranks);
+#else
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // smaller chunks aren't worth starting a thread for
+    constexpr size_t min_chunk = 1 << 16;
+    threads = std::min<size_t>(threads, (count + min_chunk - 1) / min_chunk);
+    if (threads <= 1)
+    {
+        evaluateHands(hands, results, count, ranks);
+        return;
+    }
+
+    size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; t++)
+    {
+        size_t begin = t * chunk;
+        size_t end = std::min(count, begin + chunk);
+        if (begin >= end) break;
+        workers.emplace_back(
+            evaluateHands,
+            hands + begin,
+            results + begin,
+            end - begin,
+            std::cref(ranks)
+        );
+    }
+    // the calling thread takes the first chunk
+    evaluateHands(hands, results, chunk, ranks);
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+#endif
+}
@@ -0,0 +1,143 @@
+#ifndef SRC_HANDEVALUATOR_H
+#define SRC_HANDEVALUATOR_H
+
+#include "cardtypes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// ordered from weakest to strongest so hand types can be compared directly
+enum class HandType
+{
+    HIGH_CARD,
+    PAIR,
+    TWO_PAIR,
+    THREE_OF_A_KIND,
+    STRAIGHT,
+    FLUSH,
+    FULL_HOUSE,
+    FOUR_OF_A_KIND,
+    STRAIGHT_FLUSH
+};
+
+constexpr int hand_type_count = 9;
+
+// display names, indexed by HandType
+constexpr std::array<const char *, hand_type_count> hand_names = {
+    "High Card",
+    "Pair",
+    "Two Pair",
+    "Three of a Kind",
+    "Straight",
+    "Flush",
+    "Full House",
+    "Four of a Kind",
+    "Straight Flush",
+};
+
+constexpr const char *getHandName(HandType type)
+{
+    return hand_names[static_cast<int>(type)];
+}
+
+struct HandRank
+{
+    int chips;
+    int multiplier;
+    int used = 0;
+};
+
+// chips and multiplier every hand type starts a run with, indexed by HandType
+constexpr std::array<HandRank, hand_type_count> default_hand_ranks = {{
+    {10, 1}, // High Card
+    {10, 2}, // Pair
+    {20, 2}, // Two Pair
+    {30, 3}, // Three of a Kind
+    {50, 4}, // Straight
+    {50, 5}, // Flush
+    {60, 6}, // Full House
+    {70, 7}, // Four of a Kind
+    {90, 8}, // Straight Flush
+}};
+
+// bitmask summary of a set of cards.
+// everything is packed into plain integers so building and classifying a hand never allocates.
+struct HandMask
+{
+    uint64_t rank_counts = 0; // 4 bits per rank, two is the lowest nibble
+    uint32_t suit_counts = 0; // 8 bits per suit, in CardSuits order
+    uint16_t rank_bits = 0;   // one bit per rank present, two is bit 0
+    uint8_t count = 0;
+
+    constexpr void add(CardRank rank, CardSuits suit)
+    {
+        int r = static_cast<int>(rank) - static_cast<int>(CardRank::TWO);
+        rank_counts += uint64_t(1) << (r * 4);
+        suit_counts += uint32_t(1) << (static_cast<int>(suit) * 8);
+        rank_bits |= uint16_t(1) << r;
+        count++;
+    }
+
+    constexpr void remove(CardRank rank, CardSuits suit)
+    {
+        int r = static_cast<int>(rank) - static_cast<int>(CardRank::TWO);
+        rank_counts -= uint64_t(1) << (r * 4);
+        suit_counts -= uint32_t(1) << (static_cast<int>(suit) * 8);
+        if (((rank_counts >> (r * 4)) & 0xF) == 0)
+        {
+            rank_bits &= ~(uint16_t(1) << r);
+        }
+        count--;
+    }
+};
+
+// classify the hand in a single pass over the packed counts
+HandType evaluateHand(const HandMask &hand);
+
+// hand type in the top bits and a tie-break below it, so two values compare like the hands do.
+// the tie-break holds up to 5 ranks (4 bits each), grouped by how many cards share the rank.
+using HandValue = uint32_t;
+
+constexpr int hand_value_shift = 20;
+
+constexpr HandType getHandType(HandValue value)
+{
+    return static_cast<HandType>(value >> hand_value_shift);
+}
+
+// classify up to 5 cards with one or two loads from the precomputed tables,
+// bigger hands fall back to evaluateHand and get no tie-break
+HandValue lookupHand(const HandMask &hand);
+
+// ================================  Batch evaluation  ================================
+
+// a set of cards as one bit per card, bit suit * 13 + rank - 2
+using CardMask = uint64_t;
+
+HandMask toHandMask(CardMask cards);
+
+struct HandResult
+{
+    HandValue value;
+    int score; // (hand chips + card chips) * multiplier
+};
+
+// evaluate count hands in one go, scoring them with ranks (indexed by HandType).
+// a block of masks is unpacked before any of them is looked up, the loops stay scalar.
+void evaluateHands(
+    const CardMask *hands,
+    HandResult *results,
+    size_t count,
+    const std::array<HandRank, hand_type_count> &ranks
+);
+
+// same as evaluateHands, with big batches split across threads (0 uses every core)
+void evaluateHandsParallel(
+    const CardMask *hands,
+    HandResult *results,
+    size_t count,
+    const std::array<HandRank, hand_type_count> &ranks,
+    unsigned threads = 0
+);
+
+#endif // SRC_HANDEVALUATOR_H
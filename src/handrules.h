@@ -0,0 +1,159 @@
+#ifndef SRC_HANDRULES_H
+#define SRC_HANDRULES_H
+
+#include "cardtypes.h"
+#include "handevaluator.h"
+
+// per rank and per suit card counts.
+// the reference predicates below work on this instead of the cards themselves so they can
+// also run at compile time, where they are used to check the hand lookup tables.
+struct HandCounts
+{
+    int ranks[13] = {}; // index 0 is two, 12 is ace
+    int suits[4] = {};
+    int count = 0;
+
+    constexpr void add(CardRank rank, CardSuits suit)
+    {
+        ranks[static_cast<int>(rank) - static_cast<int>(CardRank::TWO)]++;
+        suits[static_cast<int>(suit)]++;
+        count++;
+    }
+};
+
+// reference rules for every hand type, written the straightforward way
+namespace hand_rules
+{
+constexpr bool isFourOfAKind(const HandCounts &hand)
+{
+    if (hand.count < 4) return false;
+
+    for (int rank : hand.ranks)
+    {
+        if (rank >= 4)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr bool isFullHouse(const HandCounts &hand)
+{
+    if (hand.count < 5) return false;
+
+    bool three_of_a_kind = false;
+    bool pair = false;
+    for (int rank : hand.ranks)
+    {
+        three_of_a_kind |= rank == 3;
+        pair |= rank == 2;
+    }
+
+    return three_of_a_kind && pair;
+}
+
+constexpr bool isFlush(const HandCounts &hand)
+{
+    if (hand.count < 5) return false;
+
+    for (int suit : hand.suits)
+    {
+        if (suit >= 5)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr bool isStraight(const HandCounts &hand)
+{
+    if (hand.count < 5) return false;
+
+    // walk the cards from high to low, every card must be one below the last
+    int last_rank = 0;
+    for (int i = 12; i >= 0; i--)
+    {
+        for (int n = 0; n < hand.ranks[i]; n++)
+        {
+            int rank = i + static_cast<int>(CardRank::TWO);
+            if (last_rank == 0)
+            {
+                last_rank = rank;
+                continue;
+            }
+            // an ace playing low (A-5-4-3-2) comes first
+            bool ace_low = last_rank == static_cast<int>(CardRank::ACE) &&
+                           rank == static_cast<int>(CardRank::FIVE);
+            if (last_rank - rank != 1 && !ace_low) return false;
+            last_rank = rank;
+        }
+    }
+    return true;
+}
+
+constexpr bool isStraightFlush(const HandCounts &hand)
+{
+    return isStraight(hand) && isFlush(hand);
+}
+
+constexpr bool isThreeOfAKind(const HandCounts &hand)
+{
+    if (hand.count < 3) return false;
+
+    for (int rank : hand.ranks)
+    {
+        if (rank >= 3)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr bool isTwoPair(const HandCounts &hand)
+{
+    if (hand.count < 4) return false;
+
+    int pair_count = 0;
+    for (int rank : hand.ranks)
+    {
+        if (rank >= 2)
+        {
+            pair_count++;
+        }
+    }
+    return pair_count == 2;
+}
+
+constexpr bool isPair(const HandCounts &hand)
+{
+    if (hand.count < 2) return false;
+
+    for (int rank : hand.ranks)
+    {
+        if (rank >= 2)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// same order CardManager used to try the predicates in
+constexpr HandType classify(const HandCounts &hand)
+{
+    if (isStraightFlush(hand)) return HandType::STRAIGHT_FLUSH;
+    else if (isFourOfAKind(hand)) return HandType::FOUR_OF_A_KIND;
+    else if (isFullHouse(hand)) return HandType::FULL_HOUSE;
+    else if (isFlush(hand)) return HandType::FLUSH;
+    else if (isStraight(hand)) return HandType::STRAIGHT;
+    else if (isThreeOfAKind(hand)) return HandType::THREE_OF_A_KIND;
+    else if (isTwoPair(hand)) return HandType::TWO_PAIR;
+    else if (isPair(hand)) return HandType::PAIR;
+    else return HandType::HIGH_CARD;
+}
+} // namespace hand_rules
+
+#endif // SRC_HANDRULES_H
@@ -0,0 +1,258 @@
+#include "inputlog.h"
+#include <SDL3/SDL_log.h>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+
+constexpr char magic[4] = {'C', 'D', 'I', 'L'};
+constexpr uint64_t version = 1;
+
+void writeVarint(std::ofstream &file, uint64_t value)
+{
+    uint8_t bytes[10];
+    int count = 0;
+    do
+    {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        bytes[count++] = byte | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+    file.write(reinterpret_cast<const char *>(bytes), count);
+}
+
+void writePosition(std::ofstream &file, float value)
+{
+    // whole pixels as zigzag << 1, anything else as the raw bits << 1 | 1 so replays stay exact
+    if (std::abs(value) < 1e6f && value == std::trunc(value))
+    {
+        int64_t whole = static_cast<int64_t>(value);
+        uint64_t zigzag = (static_cast<uint64_t>(whole) << 1) ^ static_cast<uint64_t>(whole >> 63);
+        writeVarint(file, zigzag << 1);
+        return;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeVarint(file, (static_cast<uint64_t>(bits) << 1) | 1);
+}
+
+class Reader
+{
+private:
+    const std::vector<uint8_t> &m_data;
+    size_t m_pos = 0;
+
+public:
+    bool failed = false;
+
+    Reader(const std::vector<uint8_t> &data, size_t start) : m_data(data), m_pos(start)
+    {
+    }
+
+    bool atEnd() const
+    {
+        return m_pos >= m_data.size();
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (atEnd())
+            {
+                failed = true;
+                return 0;
+            }
+            uint8_t byte = m_data[m_pos++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return value;
+            }
+        }
+        failed = true;
+        return 0;
+    }
+
+    float position()
+    {
+        uint64_t value = varint();
+        if (value & 1)
+        {
+            uint32_t bits = static_cast<uint32_t>(value >> 1);
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+        uint64_t zigzag = value >> 1;
+        int64_t whole = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        return static_cast<float>(whole);
+    }
+};
+
+} // namespace
+
+SDL_Event InputEntry::toEvent() const
+{
+    SDL_Event event{};
+    event.type = kind == InputKind::MOUSE_DOWN ? SDL_EVENT_MOUSE_BUTTON_DOWN
+                                               : SDL_EVENT_MOUSE_BUTTON_UP;
+    event.button.button = button;
+    event.button.down = kind == InputKind::MOUSE_DOWN;
+    event.button.clicks = 1;
+    event.button.x = x;
+    event.button.y = y;
+    return event;
+}
+
+bool InputRecorder::open(const std::string &path, bool seed_fixed, uint64_t seed)
+{
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s for recording", path.c_str());
+        return false;
+    }
+    m_file.write(magic, sizeof(magic));
+    writeVarint(m_file, version);
+    writeVarint(m_file, seed_fixed ? 1 : 0);
+    writeVarint(m_file, seed);
+    m_file.flush();
+    m_last_time = 0;
+    return true;
+}
+
+bool InputRecorder::isOpen() const
+{
+    return m_file.is_open();
+}
+
+void InputRecorder::writeEntry(const InputEntry &entry)
+{
+    writeVarint(m_file, entry.time - m_last_time);
+    writeVarint(m_file, static_cast<uint64_t>(entry.kind));
+    m_last_time = entry.time;
+    if (entry.kind == InputKind::SEED)
+    {
+        writeVarint(m_file, entry.seed);
+    }
+    else
+    {
+        writeVarint(m_file, entry.button);
+        writePosition(m_file, entry.x);
+        writePosition(m_file, entry.y);
+    }
+    // a few bytes per click, flush so a crash still leaves the steps leading up to it
+    m_file.flush();
+}
+
+void InputRecorder::record(uint64_t time, const SDL_Event *event)
+{
+    if (!isOpen()) return;
+
+    InputEntry entry;
+    entry.time = time;
+    if (event->type == SDL_EVENT_MOUSE_BUTTON_DOWN)
+    {
+        entry.kind = InputKind::MOUSE_DOWN;
+    }
+    else if (event->type == SDL_EVENT_MOUSE_BUTTON_UP)
+    {
+        entry.kind = InputKind::MOUSE_UP;
+    }
+    else
+    {
+        return;
+    }
+    entry.button = event->button.button;
+    entry.x = event->button.x;
+    entry.y = event->button.y;
+    writeEntry(entry);
+}
+
+void InputRecorder::recordSeed(uint64_t time, uint64_t seed)
+{
+    if (!isOpen()) return;
+
+    InputEntry entry;
+    entry.time = time;
+    entry.kind = InputKind::SEED;
+    entry.seed = seed;
+    writeEntry(entry);
+}
+
+bool InputReplay::load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open replay %s", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> data(
+        (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()
+    );
+    if (data.size() < sizeof(magic) || std::memcmp(data.data(), magic, sizeof(magic)) != 0)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s isn't an input recording", path.c_str());
+        return false;
+    }
+
+    Reader body(data, sizeof(magic));
+    if (body.varint() != version)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s has an unknown version", path.c_str());
+        return false;
+    }
+    seed_fixed = body.varint() != 0;
+    seed = body.varint();
+
+    m_entries.clear();
+    m_cursor = 0;
+    uint64_t time = 0;
+    while (!body.atEnd() && !body.failed)
+    {
+        InputEntry entry;
+        time += body.varint();
+        entry.time = time;
+        entry.kind = static_cast<InputKind>(body.varint());
+        if (entry.kind == InputKind::SEED)
+        {
+            entry.seed = body.varint();
+        }
+        else
+        {
+            entry.button = static_cast<uint8_t>(body.varint());
+            entry.x = body.position();
+            entry.y = body.position();
+        }
+        if (!body.failed)
+        {
+            m_entries.push_back(entry);
+        }
+    }
+    if (body.failed)
+    {
+        // a recording cut short by a crash, play back what made it to disk
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s ends in a partial entry", path.c_str());
+    }
+    return true;
+}
+
+bool InputReplay::done() const
+{
+    return m_cursor >= m_entries.size();
+}
+
+const InputEntry &InputReplay::peek() const
+{
+    return m_entries[m_cursor];
+}
+
+const InputEntry &InputReplay::next()
+{
+    return m_entries[m_cursor++];
+}
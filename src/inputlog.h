@@ -0,0 +1,75 @@
+#ifndef SRC_INPUTLOG_H
+#define SRC_INPUTLOG_H
+
+// recording of the input of a session, to play it back exactly under a debugger or profiler.
+// times are game clock ms, so a replay on the virtual clock sees every click on the same step.
+//
+// file layout, every number is a LEB128 varint:
+//   "CDIL" version flags seed
+//   then entries of: time since the previous entry, kind, and the kind's data
+// mouse positions are stored as zigzag whole pixels when they are whole, raw float bits otherwise.
+
+#include <SDL3/SDL_events.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+enum class InputKind : uint8_t
+{
+    MOUSE_DOWN = 1, // button x y
+    MOUSE_UP = 2,   // button x y
+    SEED = 3,       // seed of a run started by the event before it
+};
+
+struct InputEntry
+{
+    uint64_t time = 0; // game clock ms
+    InputKind kind = InputKind::MOUSE_DOWN;
+    uint8_t button = 0;
+    float x = 0;
+    float y = 0;
+    uint64_t seed = 0;
+
+    // the SDL event to feed back, only for the mouse kinds
+    SDL_Event toEvent() const;
+};
+
+class InputRecorder
+{
+private:
+    std::ofstream m_file;
+    uint64_t m_last_time = 0;
+
+    void writeEntry(const InputEntry &entry);
+
+public:
+    // seed_fixed and seed are what the session starts with, before any run
+    bool open(const std::string &path, bool seed_fixed, uint64_t seed);
+    bool isOpen() const;
+
+    // the mouse button events, everything else is dropped since the game doesn't read it
+    void record(uint64_t time, const SDL_Event *event);
+    void recordSeed(uint64_t time, uint64_t seed);
+};
+
+class InputReplay
+{
+private:
+    std::vector<InputEntry> m_entries;
+    size_t m_cursor = 0;
+
+public:
+    bool seed_fixed = false;
+    uint64_t seed = 0;
+
+    bool load(const std::string &path);
+
+    bool done() const;
+
+    // the next entry, only valid when not done
+    const InputEntry &peek() const;
+    const InputEntry &next();
+};
+
+#endif // SRC_INPUTLOG_H
@@ -0,0 +1,354 @@
+#include "journal.h"
+#include <SDL3/SDL_log.h>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+
+constexpr char journal_magic[4] = {'C', 'D', 'J', 'R'};
+
+void putVarint(std::vector<uint8_t> &data, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        data.push_back(byte | (value != 0 ? 0x80 : 0));
+    } while (value != 0);
+}
+
+bool getVarint(const std::vector<uint8_t> &data, size_t &pos, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < data.size(); shift += 7)
+    {
+        uint8_t byte = data[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasValue(JournalAction action)
+{
+    return action == JournalAction::SELECT || action == JournalAction::TAKE_TAROT ||
+           action == JournalAction::SELL_TAROT;
+}
+
+std::string checkpointPath(const std::string &dir)
+{
+    return dir + "autosave.sav";
+}
+
+std::string journalPath(const std::string &dir)
+{
+    return dir + "autosave.journal";
+}
+
+} // namespace
+
+void applyJournalEntry(GameRules &rules, const JournalEntry &entry)
+{
+    switch (entry.action)
+    {
+        case JournalAction::SELECT:
+            rules.selectCard(entry.value);
+            break;
+        case JournalAction::PLAY:
+            rules.playSelectedCards();
+            break;
+        case JournalAction::DISCARD:
+            rules.discardSelectedCards();
+            break;
+        case JournalAction::RESOLVE:
+            rules.finishScoring();
+            rules.resolveHand();
+            break;
+        case JournalAction::NEW_ROUND:
+            rules.newRound();
+            break;
+        case JournalAction::TAKE_TAROT:
+            rules.takeTarot(entry.value);
+            break;
+        case JournalAction::SELL_TAROT:
+            rules.sellTarot(entry.value);
+            break;
+    }
+}
+
+ActionJournal::~ActionJournal()
+{
+    close();
+}
+
+void ActionJournal::open(const std::string &dir)
+{
+    if (m_open) return;
+
+    m_checkpoint_path = checkpointPath(dir);
+    m_journal_path = journalPath(dir);
+    m_stopping = false;
+    m_has_checkpoint = false;
+    m_entry_count = 0;
+
+    // carry on numbering from the checkpoint on disk, so a new one never reuses its generation
+    std::vector<uint8_t> data;
+    if (readFile(m_checkpoint_path, data) && data.size() >= sizeof(uint64_t))
+    {
+        std::memcpy(&m_generation, data.data(), sizeof(uint64_t));
+    }
+
+    m_open = true;
+#ifndef __EMSCRIPTEN__
+    m_writer = std::thread(&ActionJournal::run, this);
+#endif
+}
+
+void ActionJournal::close()
+{
+    if (!m_open) return;
+
+#ifdef __EMSCRIPTEN__
+    m_open = false;
+#else
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_writer.join();
+    m_open = false;
+#endif
+    closeFile();
+}
+
+void ActionJournal::closeFile()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool ActionJournal::isOpen() const
+{
+    return m_open;
+}
+
+void ActionJournal::append(const JournalEntry &entry)
+{
+    if (!m_open) return;
+
+    std::unique_lock lock(m_mutex);
+    if (!m_has_checkpoint) return;
+
+    m_pending.push_back(static_cast<uint8_t>(entry.action));
+    if (hasValue(entry.action))
+    {
+        putVarint(m_pending, entry.value);
+    }
+    m_entry_count++;
+#ifdef __EMSCRIPTEN__
+    // the web build has no threads, a few bytes written right away
+    std::optional<std::vector<uint8_t>> checkpoint;
+    std::vector<uint8_t> entries;
+    entries.swap(m_pending);
+    lock.unlock();
+    write(checkpoint, entries, m_generation, false);
+#endif
+}
+
+size_t ActionJournal::entryCount()
+{
+    std::lock_guard lock(m_mutex);
+    return m_entry_count;
+}
+
+void ActionJournal::compact(const RunSnapshot &snapshot)
+{
+    if (!m_open) return;
+
+    std::vector<uint8_t> data(sizeof(uint64_t));
+    std::vector<uint8_t> packed = packSnapshot(snapshot);
+    data.insert(data.end(), packed.begin(), packed.end());
+
+    std::unique_lock lock(m_mutex);
+    // the snapshot already has every action queued so far
+    m_pending.clear();
+    m_clear = false;
+    m_generation++;
+    std::memcpy(data.data(), &m_generation, sizeof(uint64_t));
+    m_checkpoint = std::move(data);
+    m_has_checkpoint = true;
+    m_entry_count = 0;
+#ifdef __EMSCRIPTEN__
+    std::optional<std::vector<uint8_t>> checkpoint;
+    checkpoint.swap(m_checkpoint);
+    lock.unlock();
+    write(checkpoint, {}, m_generation, false);
+#else
+    lock.unlock();
+    m_wake.notify_one();
+#endif
+}
+
+void ActionJournal::clear()
+{
+    if (!m_open) return;
+
+    std::unique_lock lock(m_mutex);
+    m_pending.clear();
+    m_checkpoint.reset();
+    m_has_checkpoint = false;
+    m_clear = true;
+    m_entry_count = 0;
+#ifdef __EMSCRIPTEN__
+    std::optional<std::vector<uint8_t>> checkpoint;
+    m_clear = false;
+    lock.unlock();
+    write(checkpoint, {}, m_generation, true);
+#else
+    lock.unlock();
+    m_wake.notify_one();
+#endif
+}
+
+void ActionJournal::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        // batch whatever arrives within the interval, a checkpoint or stop goes out right away
+        m_wake.wait_for(lock, flush_interval, [this] {
+            return m_stopping || m_clear || m_checkpoint.has_value();
+        });
+
+        std::optional<std::vector<uint8_t>> checkpoint;
+        checkpoint.swap(m_checkpoint);
+        std::vector<uint8_t> entries;
+        entries.swap(m_pending);
+        uint64_t generation = m_generation;
+        bool clear = m_clear;
+        m_clear = false;
+        bool stopping = m_stopping;
+
+        lock.unlock();
+        write(checkpoint, entries, generation, clear);
+        lock.lock();
+
+        if (stopping)
+        {
+            break;
+        }
+    }
+}
+
+void ActionJournal::write(
+    std::optional<std::vector<uint8_t>> &checkpoint,
+    const std::vector<uint8_t> &entries,
+    uint64_t generation,
+    bool clear
+)
+{
+    if (clear)
+    {
+        closeFile();
+        std::error_code error;
+        std::filesystem::remove(m_checkpoint_path, error);
+        std::filesystem::remove(m_journal_path, error);
+    }
+
+    if (checkpoint)
+    {
+        // checkpoint first: a crash before the journal restarts leaves an old generation journal,
+        // which recovery skips since the checkpoint already has its actions. nothing more goes
+        // into the old journal even if the checkpoint fails.
+        closeFile();
+        if (!writeFileAtomic(m_checkpoint_path, *checkpoint))
+        {
+            return;
+        }
+        m_file = std::fopen(m_journal_path.c_str(), "wb");
+        if (m_file)
+        {
+            std::fwrite(journal_magic, 1, sizeof(journal_magic), m_file);
+            std::fwrite(&generation, 1, sizeof(generation), m_file);
+            syncFile(m_file);
+        }
+    }
+
+    if (!entries.empty() && m_file)
+    {
+        // synced with every batch, an action is kept through a power loss once it's written.
+        // on the writer thread, the main thread never waits for the disk
+        bool written = std::fwrite(entries.data(), 1, entries.size(), m_file) == entries.size();
+        if (!written || !syncFile(m_file))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't append to the journal");
+        }
+    }
+}
+
+bool ActionJournal::hasCheckpoint(const std::string &dir)
+{
+    std::error_code error;
+    return std::filesystem::exists(checkpointPath(dir), error);
+}
+
+bool ActionJournal::recover(
+    const std::string &dir,
+    RunSnapshot &snapshot,
+    std::vector<JournalEntry> &entries
+)
+{
+    entries.clear();
+
+    std::vector<uint8_t> data;
+    if (!readFile(checkpointPath(dir), data) || data.size() < sizeof(uint64_t))
+    {
+        return false;
+    }
+    uint64_t generation;
+    std::memcpy(&generation, data.data(), sizeof(uint64_t));
+    if (!unpackSnapshot(data.data() + sizeof(uint64_t), data.size() - sizeof(uint64_t), snapshot))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "The autosave is from another version");
+        return false;
+    }
+
+    if (!readFile(journalPath(dir), data))
+    {
+        return true;
+    }
+    size_t header_size = sizeof(journal_magic) + sizeof(uint64_t);
+    if (data.size() < header_size ||
+        std::memcmp(data.data(), journal_magic, sizeof(journal_magic)) != 0)
+    {
+        return true;
+    }
+    uint64_t journal_generation;
+    std::memcpy(&journal_generation, data.data() + sizeof(journal_magic), sizeof(uint64_t));
+    if (journal_generation != generation)
+    {
+        return true;
+    }
+
+    size_t pos = header_size;
+    while (pos < data.size())
+    {
+        JournalEntry entry;
+        entry.action = static_cast<JournalAction>(data[pos++]);
+        if (hasValue(entry.action) && !getVarint(data, pos, entry.value))
+        {
+            // the last write was cut short, everything before it still counts
+            break;
+        }
+        entries.push_back(entry);
+    }
+    return true;
+}
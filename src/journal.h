@@ -0,0 +1,113 @@
+#ifndef SRC_JOURNAL_H
+#define SRC_JOURNAL_H
+
+// crash safe autosave: a checkpoint snapshot plus an append-only journal of the actions since.
+// an action is a couple of bytes queued under a lock, a background thread batches them to disk,
+// so the main thread never waits on a file. every so often the run is compacted into a new
+// checkpoint and the journal starts over. on launch the journal is replayed onto the checkpoint.
+//
+// the checkpoint and the journal both carry a generation, a journal of another generation than
+// the checkpoint is already part of it (a crash between writing the two) and is ignored.
+
+#include "gamestate.h"
+#include "savegame.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class JournalAction : uint8_t
+{
+    SELECT = 1, // value is the hand card index
+    PLAY = 2,
+    DISCARD = 3,
+    RESOLVE = 4, // the played hand was scored and resolved
+    NEW_ROUND = 5,
+    TAKE_TAROT = 6, // value is the offered tarot index
+    SELL_TAROT = 7, // value is the held tarot index
+};
+
+struct JournalEntry
+{
+    JournalAction action;
+    uint64_t value = 0;
+};
+
+// redo an action on the rules, the same state and actions always give the same result
+void applyJournalEntry(GameRules &rules, const JournalEntry &entry);
+
+class ActionJournal
+{
+private:
+    std::string m_checkpoint_path;
+    std::string m_journal_path;
+    std::FILE *m_file = nullptr; // only touched by the writer thread once it runs
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::thread m_writer;
+    std::vector<uint8_t> m_pending;                  // entries not written yet
+    std::optional<std::vector<uint8_t>> m_checkpoint; // compaction not written yet
+    bool m_clear = false;                            // delete both files
+    bool m_stopping = false;
+    bool m_open = false;
+    bool m_has_checkpoint = false; // entries only mean something on top of a checkpoint
+    uint64_t m_generation = 0;
+    size_t m_entry_count = 0; // since the last checkpoint
+
+    void run();
+
+    void closeFile();
+
+    // with the mutex released, only from the writer thread or with no writer thread
+    void write(
+        std::optional<std::vector<uint8_t>> &checkpoint,
+        const std::vector<uint8_t> &entries,
+        uint64_t generation,
+        bool clear
+    );
+
+public:
+    static constexpr auto flush_interval = std::chrono::milliseconds(200);
+
+    ActionJournal() = default;
+    ~ActionJournal();
+
+    ActionJournal(const ActionJournal &) = delete;
+    ActionJournal &operator=(const ActionJournal &) = delete;
+
+    // files go in dir, which must end with a separator
+    void open(const std::string &dir);
+
+    // write everything queued and stop the writer
+    void close();
+
+    bool isOpen() const;
+
+    // dropped until the first checkpoint of the session
+    void append(const JournalEntry &entry);
+
+    size_t entryCount();
+
+    // the snapshot covers everything appended so far
+    void compact(const RunSnapshot &snapshot);
+
+    // the run is over, nothing to continue
+    void clear();
+
+    static bool hasCheckpoint(const std::string &dir);
+
+    // the checkpoint and the actions to replay onto it, false if there is no checkpoint
+    static bool recover(
+        const std::string &dir,
+        RunSnapshot &snapshot,
+        std::vector<JournalEntry> &entries
+    );
+};
+
+#endif // SRC_JOURNAL_H
@@ -346,6 +346,25 @@ void WidgetLayout::mouseClickEvent(const SDL_MouseButtonEvent *event)
     }
 }
 
+bool WidgetLayout::hitsActiveWidget(SDL_FPoint mouse)
+{
+    if (!SDL_PointInRectFloat(&mouse, &m_bounding_rect)) return false;
+
+    for (auto &widget : m_widget_childs)
+    {
+        if (!widget->isVisible() || !widget->isActive() || !widget->isClickable())
+        {
+            continue;
+        }
+        SDL_FRect rect = widget->getRect();
+        if (SDL_PointInRectFloat(&mouse, &rect))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 Layout::Layout(LayoutProp prop)
 {
     m_rect = {0, 0, prop.width, prop.height};
@@ -574,3 +593,17 @@ void Layout::mouseClickEvent(const SDL_MouseButtonEvent *event)
         }
     }
 }
+
+bool Layout::hitsActiveWidget(SDL_FPoint mouse)
+{
+    if (!SDL_PointInRectFloat(&mouse, &m_bounding_rect)) return false;
+
+    for (auto &child_layout : m_layout_childs)
+    {
+        if (child_layout->hitsActiveWidget(mouse))
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -36,6 +36,9 @@ public:
 
     virtual void mouseClickEvent(const SDL_MouseButtonEvent *event) = 0;
 
+    // whether a click there would land on a visible, active clickable widget
+    virtual bool hitsActiveWidget(SDL_FPoint mouse) = 0;
+
     virtual SDL_FRect getRect();
 
     virtual SDL_FRect getBoundingRect();
@@ -79,6 +82,8 @@ public:
 
     void mouseClickEvent(const SDL_MouseButtonEvent *event) override;
 
+    bool hitsActiveWidget(SDL_FPoint mouse) override;
+
     void setRect(SDL_FRect rect) override;
 
     void recalculateBoundingRect();
@@ -104,6 +109,8 @@ public:
 
     void mouseClickEvent(const SDL_MouseButtonEvent *event) override;
 
+    bool hitsActiveWidget(SDL_FPoint mouse) override;
+
     void setRect(SDL_FRect rect) override;
 
     void recalculateBoundingRect();
@@ -1,4 +1,7 @@
 #include "game.h"
+#include "inputlog.h"
+#include "random.h"
+#include "textatlas.h"
 #include "textrenderer.h"
 #include "texturemanager.h"
 #include "typedef.h"
@@ -8,7 +11,10 @@
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_pixels.h>
 #include <SDL3/SDL_render.h>
+#include <SDL3/SDL_timer.h>
 #include <SDL3/SDL_video.h>
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 struct AppContext
@@ -17,8 +23,58 @@ struct AppContext
     SDL_Renderer *renderer = nullptr;
     Game *game = nullptr;
     unsigned int last_tick = 0;
+    InputRecorder recorder;
+    uint32_t recorded_runs = 0;
+    InputReplay replay;
+    bool replaying = false;
 };
 
+// note the seed of every game started since the last call, so a replay deals the same cards
+void recordNewRuns(AppContext *context)
+{
+    Game *game = context->game;
+    if (game->getRunsStarted() == context->recorded_runs) return;
+
+    context->recorded_runs = game->getRunsStarted();
+    context->recorder.recordSeed(game->clock.now(), game->getSeed());
+}
+
+// feed the recording back on the virtual clock, one step at a time so every click lands on the
+// same step it was made on
+void playReplay(AppContext *context, float delta)
+{
+    Game *game = context->game;
+    InputReplay &replay = context->replay;
+    int steps = static_cast<int>(std::lround(delta * 1000 / GameClock::step_ms));
+    steps = std::clamp(steps, 1, 25);
+    for (int i = 0; i < steps; i++)
+    {
+        while (!replay.done() && replay.peek().time <= game->clock.now())
+        {
+            InputEntry entry = replay.next();
+            if (entry.kind == InputKind::SEED) continue;
+
+            // the seed of a game this click starts is stored right after it
+            if (!replay.done() && replay.peek().kind == InputKind::SEED)
+            {
+                game->setNextRunSeed(replay.peek().seed);
+            }
+            SDL_Event event = entry.toEvent();
+            game->registerMouseEvents(&event);
+        }
+        if (replay.done())
+        {
+            unsigned long long now = game->clock.now();
+            SDL_Log("Replay finished at %llu ms", now);
+            context->replaying = false;
+            game->clock.setVirtual(false);
+            return;
+        }
+        game->clock.advanceBy(GameClock::step_ms);
+        game->update(0);
+    }
+}
+
 SDL_AppResult SDL_AppInit(void **appcontext, int argc, char *argv[])
 {
     AppContext *const context = new AppContext();
@@ -83,6 +139,68 @@ SDL_AppResult SDL_AppInit(void **appcontext, int argc, char *argv[])
     context->game = new Game();
     context->last_tick = SDL_GetTicks();
 
+    // --seed <number> plays every run with the same deck and tarot order
+    // --record <file> saves the input of the session, --replay <file> plays one back
+    // --load <file> starts from a saved run, e.g. a late stage to profile
+    std::string record_path;
+    std::string replay_path;
+    std::string load_path;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--seed")
+        {
+            uint64_t seed;
+            if (i + 1 < argc && parseSeed(argv[i + 1], seed))
+            {
+                context->game->setSeed(seed);
+                i++;
+            }
+            else
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "--seed needs a decimal number");
+            }
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replay_path = argv[++i];
+        }
+        else if (arg == "--load" && i + 1 < argc)
+        {
+            load_path = argv[++i];
+        }
+    }
+
+    if (!replay_path.empty() && context->replay.load(replay_path))
+    {
+        if (context->replay.seed_fixed)
+        {
+            context->game->setSeed(context->replay.seed);
+        }
+        context->game->clock.setVirtual(true);
+        context->replaying = true;
+        context->game->disableAutosave();
+    }
+    else if (!record_path.empty())
+    {
+        Game *game = context->game;
+        context->recorder.open(record_path, game->isSeedFixed(), game->getSeed());
+    }
+
+    if (!load_path.empty())
+    {
+        // a loaded scenario must not replace the autosaved run
+        context->game->disableAutosave();
+        if (!context->game->loadRun(load_path))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s", load_path.c_str());
+        }
+    }
+
     SDL_SetRenderVSync(context->renderer, 1);
 
     return SDL_APP_CONTINUE; /* carry on with the program! */
@@ -96,7 +214,15 @@ SDL_AppResult SDL_AppEvent(void *appcontext, SDL_Event *event)
         return SDL_APP_SUCCESS;
     }
 
+    // the recording is the only input while it plays back
+    if (context->replaying)
+    {
+        return SDL_APP_CONTINUE;
+    }
+
+    context->recorder.record(context->game->clock.now(), event);
     context->game->registerMouseEvents(event);
+    recordNewRuns(context);
 
     return SDL_APP_CONTINUE;
 }
@@ -111,7 +237,14 @@ SDL_AppResult SDL_AppIterate(void *appcontext)
     SDL_SetRenderDrawColor(context->renderer, 150, 134, 129, SDL_ALPHA_OPAQUE);
     SDL_RenderClear(context->renderer);
 
-    context->game->update(delta);
+    if (context->replaying)
+    {
+        playReplay(context, delta);
+    }
+    else
+    {
+        context->game->update(delta);
+    }
     context->game->render(context->renderer);
 
     if (context->game->exit())
@@ -127,6 +260,11 @@ SDL_AppResult SDL_AppIterate(void *appcontext)
 void SDL_AppQuit(void *appcontext, SDL_AppResult result)
 {
     AppContext *const context = (AppContext *)appcontext;
+    if (context->game)
+    {
+        context->game->saveResume();
+    }
+    TextAtlas::instance()->clear();
     SDL_DestroyRenderer(context->renderer);
     SDL_DestroyWindow(context->window);
     delete context->game;
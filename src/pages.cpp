@@ -234,6 +234,12 @@ void Pages::registerMouseEvents(SDL_Event *event)
     pagestack.back()->getRootLayout()->registerMouseEvents(event);
 }
 
+bool Pages::hitsActiveWidget(SDL_FPoint mouse)
+{
+    if (pagestack.empty()) return false;
+    return pagestack.back()->getRootLayout()->hitsActiveWidget(mouse);
+}
+
 void Pages::render(SDL_Renderer *renderer)
 {
     if (pagestack.empty()) return;
@@ -271,6 +277,8 @@ MainMenu::MainMenu(Game *game) : Pages(game)
     Label *label1;
     MainButton *playGamebtn;
     MainButton *exitGamebtn;
+    MainButton *pasteSeedbtn;
+    MainButton *randomSeedbtn;
     TextureAtlas *atlas = TextureManager::instance()->getAtlas("ui-atlas");
     Page *page = create(
         "game",
@@ -296,11 +304,24 @@ MainMenu::MainMenu(Game *game) : Pages(game)
     )
         .addWidget<Label>("label1", &label1, Text(font, "Main Menu"))
         .addWidget<MainButton>("play", &playGamebtn, Text(font, "Play"))
+        .addWidget<MainButton>("continue", &continue_button, Text(font, "Continue"))
+        .addWidget<Label>(
+            "seed",
+            &seed_label,
+            Text(FontsManager::getFont("font2-w"), "Seed: random")
+        )
+        .addWidget<MainButton>("paste_seed", &pasteSeedbtn, Text(font, "Paste Seed"))
+        .addWidget<MainButton>("random_seed", &randomSeedbtn, Text(font, "Random Seed"))
+        .addWidget<MainButton>("click_skip", &click_skip_button, Text(font, "Click Skip: On"))
         .addWidget<MainButton>("exit", &exitGamebtn, Text(font, "Exit"))
         .endWidgetLayout();
 
     playGamebtn->onClick([this](SDL_FPoint mouse) { this->game_ref->toGame(); });
+    continue_button->onClick([this](SDL_FPoint mouse) { this->game_ref->continueRun(); });
     exitGamebtn->onClick([this](SDL_FPoint mouse) { this->game_ref->requestExit(); });
+    pasteSeedbtn->onClick([this](SDL_FPoint mouse) { this->game_ref->pasteSeed(); });
+    randomSeedbtn->onClick([this](SDL_FPoint mouse) { this->game_ref->randomizeSeed(); });
+    click_skip_button->onClick([this](SDL_FPoint mouse) { this->game_ref->toggleClickToSkip(); });
     playGamebtn->setBackgroundTexture(atlas->getAtlas(), atlas->getTextureInfo("button-big").rect);
     exitGamebtn->setBackgroundTexture(atlas->getAtlas(), atlas->getTextureInfo("button-big").rect);
 }
@@ -583,7 +604,14 @@ GamePage::GamePage(Game *game) : Pages(game)
         .beginWidgetLayout(
             "button_group",
             nullptr,
-            {.layout_type = LayoutType::VERTICAL, .height = 120, .gap = 10}
+            {.layout_type = LayoutType::VERTICAL, .height = 180, .gap = 10}
+        )
+        .addWidget<PrimaryButton>(
+            "speed_button",
+            &speed_button,
+            Text(FontsManager::getFont("font2-w"), "Speed: 1x"),
+            "button-1",
+            Float4{10, 35, 10, 35}
         )
         .addWidget<PrimaryButton>(
             "combo_info_button",
@@ -604,55 +632,57 @@ GamePage::GamePage(Game *game) : Pages(game)
         .endLayout();
 
     exit_button->onClick([=](SDL_FPoint pos) { game->toMainMenu(); });
+    speed_button->onClick([=](SDL_FPoint pos) { game->cycleScoringSpeed(); });
 
 
 
-    Layout *tarort_container;
-    WidgetLayout *tarot_layout;
-
     page->beginLayout(
             "content_container",
             nullptr,
             LayoutProp{.layout_type = LayoutType::VERTICAL, .gap = 15}
     )
-        // TODO: add tarot cards
-        // .beginLayout("tarot_container", &tarort_container, LayoutProp{.height = 200})
-        // .beginWidgetLayout(
-        //     "tarot_layout",
-        //     &tarot_layout,
-        //     LayoutProp{
-        //         .layout_type = LayoutType::HORIZONTAL,
-        //         .horizontal_anchor = Anchor::CENTER,
-        //         .vertical_anchor = Anchor::CENTER,
-        //         .gap = 10
-        //     }
-        // )
-        // .addWidget<CardWidget>("tarot-1", &tarot_active[0], nullptr)
-        // .addWidget<CardWidget>("tarot-2", &tarot_active[1], nullptr)
-        // .addWidget<CardWidget>("tarot-3", &tarot_active[2], nullptr)
-        // .addWidget<CardWidget>("tarot-4", &tarot_active[3], nullptr)
-        // .addWidget<CardWidget>("tarot-5", &tarot_active[4], nullptr)
-        // .addWidget<CardWidget>("tarot-6", &tarot_active[5], nullptr)
-        // .endWidgetLayout()
-        // .beginWidgetLayout(
-        //     "tarot_action",
-        //     nullptr,
-        //     LayoutProp{
-        //         .layout_type = LayoutType::VERTICAL,
-        //         .width = 150,
-        //         .horizontal_anchor = Anchor::CENTER,
-        //         .vertical_anchor = Anchor::CENTER,
-        //         .gap = 10
-        //     }
-        // )
-        // .addWidget<PrimaryButton>(
-        //     "button_tarot_sell",
-        //     nullptr,
-        //     Text(FontsManager::getFont("font2-w"), "Sell"),
-        //     "button-3"
-        // )
-        // .endWidgetLayout()
-        // .endLayout()
+        .beginLayout("tarot_container", nullptr, LayoutProp{.height = 200})
+        .beginWidgetLayout(
+            "tarot_layout",
+            nullptr,
+            LayoutProp{
+                .layout_type = LayoutType::HORIZONTAL,
+                .horizontal_anchor = Anchor::CENTER,
+                .vertical_anchor = Anchor::CENTER,
+                .gap = 10
+            }
+        )
+        .addWidget<CardWidget>("tarot-1", &tarot_active[0], nullptr)
+        .addWidget<CardWidget>("tarot-2", &tarot_active[1], nullptr)
+        .addWidget<CardWidget>("tarot-3", &tarot_active[2], nullptr)
+        .addWidget<CardWidget>("tarot-4", &tarot_active[3], nullptr)
+        .addWidget<CardWidget>("tarot-5", &tarot_active[4], nullptr)
+        .addWidget<CardWidget>("tarot-6", &tarot_active[5], nullptr)
+        .endWidgetLayout()
+        .beginWidgetLayout(
+            "tarot_action",
+            nullptr,
+            LayoutProp{
+                .layout_type = LayoutType::VERTICAL,
+                .width = 300,
+                .horizontal_anchor = Anchor::CENTER,
+                .vertical_anchor = Anchor::CENTER,
+                .gap = 10
+            }
+        )
+        .addWidget<Label>(
+            "tarot_description",
+            &tarot_description,
+            Text(FontsManager::getFont("font3-w"), "")
+        )
+        .addWidget<PrimaryButton>(
+            "button_tarot_sell",
+            &tarot_sell_button,
+            Text(FontsManager::getFont("font2-w"), "Sell"),
+            "button-3"
+        )
+        .endWidgetLayout()
+        .endLayout()
 
         .beginLayout(
             "cards_container",
@@ -743,6 +773,12 @@ GamePage::GamePage(Game *game) : Pages(game)
             Text(FontsManager::getFont("font2-w"), "Discard"),
             "button-5"
         )
+        .addWidget<PrimaryButton>(
+            "button_hand_hint",
+            &hint_button,
+            Text(FontsManager::getFont("font2-w"), "Hint"),
+            "button-3"
+        )
         .endWidgetLayout()
         .endLayout()
 
@@ -754,6 +790,12 @@ GamePage::GamePage(Game *game) : Pages(game)
         hand_card[i]->onClick([=, this](SDL_FPoint pos) { game_ref->selectCard(i); });
     }
 
+    for (int i = 0; i < tarot_active.size(); i++)
+    {
+        tarot_active[i]->onClick([=, this](SDL_FPoint pos) { game_ref->selectTarot(i); });
+    }
+    tarot_sell_button->onClick([=, this](SDL_FPoint pos) { game_ref->sellSelectedTarot(); });
+
     // hide first
     for (int i = 0; i < played_card.size(); i++)
     {
@@ -763,6 +805,7 @@ GamePage::GamePage(Game *game) : Pages(game)
 
     play_button->onClick([=, this](SDL_FPoint pos) { game_ref->playHandSelectedCards(); });
     discard_button->onClick([=, this](SDL_FPoint pos) { game_ref->discardHandSelectedCards(); });
+    hint_button->onClick([=, this](SDL_FPoint pos) { game_ref->suggestBestPlay(); });
 
 
     win_round_overlay = create(
@@ -785,7 +828,7 @@ GamePage::GamePage(Game *game) : Pages(game)
             LayoutProp{
                 .layout_type = LayoutType::VERTICAL,
                 .width = 600,
-                .height = 400,
+                .height = 640,
                 .horizontal_anchor = Anchor::CENTER,
                 .vertical_anchor = Anchor::CENTER,
                 .gap = 10,
@@ -856,6 +899,31 @@ GamePage::GamePage(Game *game) : Pages(game)
         )
         .endWidgetLayout()
         .endLayout()
+        .beginWidgetLayout(
+            "offer-label-container",
+            nullptr,
+            LayoutProp{.height = 30, .horizontal_anchor = Anchor::CENTER}
+        )
+        .addWidget<Label>(
+            "offer-label",
+            &tarot_offer_label,
+            Text(FontsManager::getFont("font3-w"), "")
+        )
+        .endWidgetLayout()
+        .beginWidgetLayout(
+            "offer",
+            nullptr,
+            LayoutProp{
+                .height = 170,
+                .horizontal_anchor = Anchor::CENTER,
+                .vertical_anchor = Anchor::CENTER,
+                .gap = 10
+            }
+        )
+        .addWidget<CardWidget>("offer-1", &tarot_offer[0], nullptr)
+        .addWidget<CardWidget>("offer-2", &tarot_offer[1], nullptr)
+        .addWidget<CardWidget>("offer-3", &tarot_offer[2], nullptr)
+        .endWidgetLayout()
         .beginWidgetLayout(
             "next-button-container",
             nullptr,
@@ -879,6 +947,11 @@ GamePage::GamePage(Game *game) : Pages(game)
         game_ref->newRound();
     });
 
+    for (int i = 0; i < tarot_offer.size(); i++)
+    {
+        tarot_offer[i]->onClick([=, this](SDL_FPoint pos) { game_ref->takeTarot(i); });
+    }
+
     Page *combo_info = create(
         "combo_info",
         LayoutProp{
@@ -1224,21 +1297,24 @@ GamePage::GamePage(Game *game) : Pages(game)
         .endWidgetLayout()
         .endLayout();
 
+    // look the labels up once here instead of by name every time the overlay opens
+    for (int i = 0; i < hand_type_count; i++)
+    {
+        std::string name = hand_names[i];
+        combo_info_text[i] = combo_info->getWidget<Label>(name + "-text");
+        combo_info_used[i] = combo_info->getWidget<Label>(name + "-used");
+    }
+
     combo_info_button->onClick([=, this](SDL_FPoint pos) {
-        Page *combo_info_overlay = this->get("combo_info");
-        for (auto rank : game_ref->card_manager.hand_ranks)
+        auto &hand_ranks = game_ref->rules.state.card_manager.hand_ranks;
+        for (int i = 0; i < hand_type_count; i++)
         {
-            combo_info_overlay->getWidget<Label>(rank.first + "-label")
-                ->setText(rank.first.c_str());
-
-            std::string text =
-                std::to_string(rank.second.chips) + " x " + std::to_string(rank.second.multiplier);
-            combo_info_overlay->getWidget<Label>(rank.first + "-text")->setText(text.c_str());
-
-            combo_info_overlay->getWidget<Label>(rank.first + "-used")
-                ->setText(std::to_string(rank.second.used).c_str());
+            HandRank &rank = hand_ranks[i];
+            std::string text = std::to_string(rank.chips) + " x " + std::to_string(rank.multiplier);
+            combo_info_text[i]->setText(text.c_str());
+            combo_info_used[i]->setText(std::to_string(rank.used).c_str());
         }
-        this->push(combo_info_overlay);
+        this->push(this->get("combo_info"));
     });
     combo_info_close_btn->onClick([=, this](SDL_FPoint pos) { this->pop(); });
 
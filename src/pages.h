@@ -1,7 +1,9 @@
 #ifndef SRC_PAGES_H
 #define SRC_PAGES_H
 
+#include "handevaluator.h"
 #include "layout.h"
+#include "tarot.h"
 #include "typedef.h"
 #include "widget.h"
 #include <SDL3/SDL_log.h>
@@ -92,6 +94,9 @@ public:
 
     virtual void registerMouseEvents(SDL_Event *event);
 
+    // whether a click there would land on something in the page on top
+    bool hitsActiveWidget(SDL_FPoint mouse);
+
     virtual void render(SDL_Renderer *renderer);
 
     virtual void update(float dt);
@@ -102,13 +107,19 @@ public:
 class MainMenu : public Pages
 {
 public:
+    Label *seed_label;
+    MainButton *continue_button;
+    MainButton *click_skip_button;
+
     MainMenu(Game *game);
 };
 
 class GamePage : public Pages
 {
 public:
-    std::array<CardWidget *, 6> tarot_active;
+    std::array<CardWidget *, max_hand_tarots> tarot_active;
+    Label *tarot_description;
+    PrimaryButton *tarot_sell_button;
     std::array<CardWidget *, 9> hand_card;
     std::array<CardWidget *, 5> played_card;
 
@@ -121,8 +132,14 @@ public:
     Label *combo_chips;
     Label *combo_mult;
 
+    // combo info overlay, indexed by HandType
+    std::array<Label *, hand_type_count> combo_info_text;
+    std::array<Label *, hand_type_count> combo_info_used;
+
     PrimaryButton *play_button;
     PrimaryButton *discard_button;
+    PrimaryButton *hint_button;
+    PrimaryButton *speed_button;
 
     Label *play_counter;
     Label *discard_counter;
@@ -131,6 +148,8 @@ public:
     Label *play_reward;
     Label *discard_reward;
     Label *total_reward;
+    std::array<CardWidget *, max_showed_tarots> tarot_offer;
+    Label *tarot_offer_label;
 
     Page *game_over_overlay;
     GamePage(Game *game);
@@ -0,0 +1,41 @@
+#include "random.h"
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <random>
+
+uint64_t randomSeed()
+{
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+bool parseSeed(const char *text, uint64_t &seed)
+{
+    if (text == nullptr)
+    {
+        return false;
+    }
+    while (std::isspace(static_cast<unsigned char>(*text)))
+    {
+        text++;
+    }
+    if (!std::isdigit(static_cast<unsigned char>(*text)))
+    {
+        return false;
+    }
+
+    char *end;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    while (std::isspace(static_cast<unsigned char>(*end)))
+    {
+        end++;
+    }
+    if (errno == ERANGE || *end != '\0')
+    {
+        return false;
+    }
+    seed = value;
+    return true;
+}
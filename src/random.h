@@ -0,0 +1,222 @@
+#ifndef SRC_RANDOM_H
+#define SRC_RANDOM_H
+
+// seeded random numbers for everything that affects a run.
+// the same seed gives the same run on every platform, so nothing here goes through the standard
+// distributions or std::shuffle, whose results differ between standard libraries.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// one stream per thing that draws, so drawing more tarots never changes the cards dealt
+enum class RandomStream : uint64_t
+{
+    DECK = 1,
+    TAROT = 2,
+    BOT = 3, // decisions of simulated players
+};
+
+// PCG32 (XSH RR), 16 bytes of state and a few instructions per number
+class Pcg32
+{
+private:
+    uint64_t m_state = 0x853C49E6748FEA9BULL;
+    uint64_t m_inc = 0xDA3E39CB94B95BDBULL;
+
+public:
+    using result_type = uint32_t;
+
+    Pcg32() = default;
+
+    Pcg32(uint64_t seed, RandomStream stream)
+    {
+        this->seed(seed, stream);
+    }
+
+    void seed(uint64_t seed, RandomStream stream)
+    {
+        m_state = 0;
+        m_inc = (static_cast<uint64_t>(stream) << 1) | 1;
+        next();
+        m_state += seed;
+        next();
+    }
+
+    uint32_t next()
+    {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + m_inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // uniform in [0, bound), without the modulo bias and almost never a division
+    uint32_t bounded(uint32_t bound)
+    {
+        uint64_t product = static_cast<uint64_t>(next()) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound)
+        {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold)
+            {
+                product = static_cast<uint64_t>(next()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // so it also works as a standard UniformRandomBitGenerator
+    static constexpr uint32_t min()
+    {
+        return 0;
+    }
+
+    static constexpr uint32_t max()
+    {
+        return UINT32_MAX;
+    }
+
+    uint32_t operator()()
+    {
+        return next();
+    }
+};
+
+// fixed size pile drawn at random without shuffling it first.
+// every draw is one Fisher-Yates step: swap a random undrawn item to the cursor and step past it,
+// so drawing k items costs k steps and gives the same odds as shuffling the whole pile.
+template <typename T, size_t N> class DrawPile
+{
+    static_assert(N <= 255, "cursor and count are stored in a byte");
+
+public:
+    std::array<T, N> items{};
+    uint8_t cursor = 0; // items before the cursor have been drawn
+    uint8_t count = 0;
+
+    constexpr size_t size() const
+    {
+        return count - cursor;
+    }
+
+    constexpr bool empty() const
+    {
+        return cursor == count;
+    }
+
+    constexpr void clear()
+    {
+        cursor = 0;
+        count = 0;
+    }
+
+    // add an undrawn item, only before the first draw
+    constexpr void push_back(T item)
+    {
+        items[count++] = std::move(item);
+    }
+
+    T draw(Pcg32 &rng)
+    {
+        size_t pick = cursor + rng.bounded(count - cursor);
+        using std::swap;
+        swap(items[cursor], items[pick]);
+        return std::move(items[cursor++]);
+    }
+};
+
+// weighted draws in O(1) each with Vose's alias method, built in O(n) whenever the weights change.
+// every column keeps its own item below a threshold and hands the rest of its odds to an alias.
+// integer weights and thresholds, so the draws are the same on every platform.
+template <typename T, size_t N> class AliasTable
+{
+    static_assert(N <= 255, "aliases are stored in a byte");
+
+public:
+    std::array<T, N> items{};
+    std::array<uint32_t, N> threshold{}; // keep the column when a roll below total is under it
+    std::array<uint8_t, N> alias{};
+    uint8_t count = 0;
+    uint32_t total = 0; // sum of the weights
+
+    constexpr bool empty() const
+    {
+        return total == 0;
+    }
+
+    void build(const T *source, const uint32_t *weights, size_t size)
+    {
+        count = static_cast<uint8_t>(size);
+        total = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            items[i] = source[i];
+            total += weights[i];
+        }
+
+        // weights scaled by the count, a column is full at exactly total
+        std::array<uint64_t, N> scaled;
+        std::array<uint8_t, N> small;
+        std::array<uint8_t, N> large;
+        size_t small_count = 0;
+        size_t large_count = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            scaled[i] = static_cast<uint64_t>(weights[i]) * size;
+            alias[i] = static_cast<uint8_t>(i);
+            if (scaled[i] < total)
+            {
+                small[small_count++] = static_cast<uint8_t>(i);
+            }
+            else
+            {
+                large[large_count++] = static_cast<uint8_t>(i);
+            }
+        }
+        while (small_count > 0 && large_count > 0)
+        {
+            uint8_t less = small[--small_count];
+            uint8_t more = large[--large_count];
+            threshold[less] = static_cast<uint32_t>(scaled[less]);
+            alias[less] = more;
+            scaled[more] = scaled[more] + scaled[less] - total;
+            if (scaled[more] < total)
+            {
+                small[small_count++] = more;
+            }
+            else
+            {
+                large[large_count++] = more;
+            }
+        }
+        // whatever is left is full, up to rounding
+        while (large_count > 0)
+        {
+            threshold[large[--large_count]] = total;
+        }
+        while (small_count > 0)
+        {
+            threshold[small[--small_count]] = total;
+        }
+    }
+
+    // only when not empty
+    T sample(Pcg32 &rng) const
+    {
+        uint32_t column = rng.bounded(count);
+        return rng.bounded(total) < threshold[column] ? items[column] : items[alias[column]];
+    }
+};
+
+// a fresh seed from the system, for runs started without one
+uint64_t randomSeed();
+
+// parse a seed typed by the player, false if it isn't a plain decimal number
+bool parseSeed(const char *text, uint64_t &seed);
+
+#endif // SRC_RANDOM_H
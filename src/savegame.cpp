@@ -0,0 +1,149 @@
+#include "savegame.h"
+#include <SDL3/SDL_log.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+struct SaveHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t size; // of the snapshot after the header
+    uint32_t checksum;
+};
+
+constexpr char save_magic[4] = {'C', 'D', 'S', 'V'};
+
+// FNV-1a, only there to catch a torn or corrupted file
+uint32_t checksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+std::vector<uint8_t> packSnapshot(const RunSnapshot &snapshot)
+{
+    SaveHeader header;
+    std::memcpy(header.magic, save_magic, sizeof(save_magic));
+    header.version = save_version;
+    header.size = sizeof(RunSnapshot);
+    header.checksum = checksum(reinterpret_cast<const uint8_t *>(&snapshot), sizeof(RunSnapshot));
+
+    std::vector<uint8_t> data(sizeof(SaveHeader) + sizeof(RunSnapshot));
+    std::memcpy(data.data(), &header, sizeof(SaveHeader));
+    std::memcpy(data.data() + sizeof(SaveHeader), &snapshot, sizeof(RunSnapshot));
+    return data;
+}
+
+bool unpackSnapshot(const uint8_t *data, size_t size, RunSnapshot &snapshot)
+{
+    if (size < sizeof(SaveHeader)) return false;
+
+    SaveHeader header;
+    std::memcpy(&header, data, sizeof(SaveHeader));
+    if (std::memcmp(header.magic, save_magic, sizeof(save_magic)) != 0) return false;
+    if (header.version != save_version || header.size != sizeof(RunSnapshot)) return false;
+    if (size < sizeof(SaveHeader) + sizeof(RunSnapshot)) return false;
+
+    const uint8_t *payload = data + sizeof(SaveHeader);
+    if (checksum(payload, sizeof(RunSnapshot)) != header.checksum) return false;
+
+    std::memcpy(&snapshot, payload, sizeof(RunSnapshot));
+    return true;
+}
+
+bool syncFile(std::FILE *file)
+{
+    if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool writeFileAtomic(const std::string &path, const std::vector<uint8_t> &data)
+{
+    std::string temp_path = path + ".tmp";
+    // on the disk before the rename, or a power loss can leave the new name on an empty file
+    std::FILE *file = std::fopen(temp_path.c_str(), "wb");
+    bool written = file && std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+                   syncFile(file);
+    if (file && std::fclose(file) != 0)
+    {
+        written = false;
+    }
+    if (!written)
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s", path.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path, error);
+    if (error)
+    {
+        SDL_LogError(
+            SDL_LOG_CATEGORY_APPLICATION,
+            "Couldn't replace %s: %s",
+            path.c_str(),
+            error.message().c_str()
+        );
+        return false;
+    }
+
+#ifndef _WIN32
+    // the rename is only durable once the directory holding it is
+    std::string dir = std::filesystem::path(path).parent_path().string();
+    int dir_fd = open(dir.empty() ? "." : dir.c_str(), O_RDONLY);
+    if (dir_fd >= 0)
+    {
+        fsync(dir_fd);
+        close(dir_fd);
+    }
+#endif
+    return true;
+}
+
+bool readFile(const std::string &path, std::vector<uint8_t> &data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool saveSnapshot(const std::string &path, const RunSnapshot &snapshot)
+{
+    return writeFileAtomic(path, packSnapshot(snapshot));
+}
+
+bool loadSnapshot(const std::string &path, RunSnapshot &snapshot)
+{
+    std::vector<uint8_t> data;
+    if (!readFile(path, data)) return false;
+
+    if (!unpackSnapshot(data.data(), data.size(), snapshot))
+    {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s isn't a save of this version", path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef SRC_SAVEGAME_H
+#define SRC_SAVEGAME_H
+
+// a whole run as one fixed layout blob, to resume on launch or to start profiling at a late stage.
+// the states are plain data and are copied byte for byte, so saving and loading is a memcpy.
+// the blob only loads into a build with the same layout, the version and size in the header
+// turn anything else away instead of loading garbage.
+
+#include "gamestate.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// bump whenever GameState changes
+constexpr uint32_t save_version = 5;
+
+// the tarots are part of the game state now, kept as a struct so the format can grow
+struct RunSnapshot
+{
+    GameState game;
+};
+
+static_assert(std::is_trivially_copyable_v<RunSnapshot>);
+
+// header and snapshot in one buffer
+std::vector<uint8_t> packSnapshot(const RunSnapshot &snapshot);
+
+// false when the data is from another version or layout, or got cut short
+bool unpackSnapshot(const uint8_t *data, size_t size, RunSnapshot &snapshot);
+
+// flush a file and wait until it's on the disk, not only handed to the OS
+bool syncFile(std::FILE *file);
+
+// write to a temporary file and rename it over path, readers see the old or the new file, even
+// after a power loss
+bool writeFileAtomic(const std::string &path, const std::vector<uint8_t> &data);
+
+bool readFile(const std::string &path, std::vector<uint8_t> &data);
+
+// written to a temporary file and renamed over the old one, a crash never leaves half a save
+bool saveSnapshot(const std::string &path, const RunSnapshot &snapshot);
+
+bool loadSnapshot(const std::string &path, RunSnapshot &snapshot);
+
+#endif // SRC_SAVEGAME_H
@@ -0,0 +1,301 @@
+#include "scorepipeline.h"
+#include <algorithm>
+#include <bitset>
+
+namespace
+{
+
+constexpr uint16_t face_mask = (1 << static_cast<int>(CardRank::JACK)) |
+                               (1 << static_cast<int>(CardRank::QUEEN)) |
+                               (1 << static_cast<int>(CardRank::KING));
+
+uint8_t clampCards(int count)
+{
+    return static_cast<uint8_t>(std::clamp(count, 0, max_play_cards + 1));
+}
+
+bool sameGuards(const TarotModifier &a, const TarotModifier &b)
+{
+    return a.rank_mask == b.rank_mask && a.suit_mask == b.suit_mask &&
+           a.hand_mask == b.hand_mask && a.min_cards == b.min_cards &&
+           a.max_cards == b.max_cards && a.after == b.after;
+}
+
+bool isAdditive(const TarotModifier &modifier)
+{
+    return modifier.convert_suit < 0 && !modifier.retrigger;
+}
+
+class ModifierList
+{
+private:
+    FixedList<TarotModifier, max_tarot_modifiers> &m_list;
+    // a conversion changes the suit every later modifier sees, nothing merges across it
+    size_t m_merge_from = 0;
+
+public:
+    explicit ModifierList(FixedList<TarotModifier, max_tarot_modifiers> &list) : m_list(list)
+    {
+    }
+
+    // index the modifier ended up at, merged into one with the same guards when it only adds
+    int16_t emit(const TarotModifier &modifier)
+    {
+        if (isAdditive(modifier))
+        {
+            for (size_t i = m_merge_from; i < m_list.size(); i++)
+            {
+                TarotModifier &other = m_list[i];
+                if (isAdditive(other) && sameGuards(other, modifier))
+                {
+                    other.chips += modifier.chips;
+                    other.mult += modifier.mult;
+                    other.times *= modifier.times;
+                    return static_cast<int16_t>(i);
+                }
+            }
+        }
+        m_list.push_back(modifier);
+        if (modifier.convert_suit >= 0)
+        {
+            m_merge_from = m_list.size();
+        }
+        return static_cast<int16_t>(m_list.size() - 1);
+    }
+};
+
+// guards refine the pending modifier, effects add to it. a guard after an effect starts a new
+// modifier that only runs when the one before passed.
+void compileProgram(const TarotEffects &effects, TarotId id, int tarot, ModifierList &list)
+{
+    const TarotProgram &program = effects.programs[id];
+    TarotModifier current;
+    current.tarot = static_cast<int8_t>(tarot);
+    bool has_effect = false;
+    int converted = -1;
+
+    auto flush = [&] {
+        if (!has_effect) return;
+        int16_t after = list.emit(current);
+        current = TarotModifier();
+        current.tarot = static_cast<int8_t>(tarot);
+        current.after = after;
+        has_effect = false;
+    };
+
+    for (int pc = 0; pc < program.length; pc++)
+    {
+        const TarotInstruction &instruction = effects.code[program.start + pc];
+        int arg = instruction.arg;
+        bool guard = instruction.op >= TarotOp::IF_SUIT && instruction.op <= TarotOp::IF_MAX_CARDS;
+        if (guard)
+        {
+            flush();
+        }
+        switch (instruction.op)
+        {
+            case TarotOp::ADD_CHIPS:
+                current.chips += arg;
+                has_effect = true;
+                break;
+            case TarotOp::ADD_MULT:
+                current.mult += arg;
+                has_effect = true;
+                break;
+            case TarotOp::TIMES_MULT:
+                current.times *= arg;
+                has_effect = true;
+                break;
+            case TarotOp::IF_SUIT:
+                // the suit is known once the program converted it
+                if (converted >= 0)
+                {
+                    if (converted != arg) return;
+                    break;
+                }
+                current.suit_mask &= 1 << arg;
+                break;
+            case TarotOp::IF_RANK:
+                current.rank_mask &= 1 << arg;
+                break;
+            case TarotOp::IF_RANK_MAX:
+                current.rank_mask &= (1 << (arg + 1)) - 1;
+                break;
+            case TarotOp::IF_FACE:
+                current.rank_mask &= face_mask;
+                break;
+            case TarotOp::IF_HAND:
+                current.hand_mask &= 1 << arg;
+                break;
+            case TarotOp::IF_MIN_CARDS:
+                current.min_cards = std::max(current.min_cards, clampCards(arg));
+                break;
+            case TarotOp::IF_MAX_CARDS:
+                current.max_cards = std::min(current.max_cards, clampCards(arg));
+                break;
+            case TarotOp::CONVERT_SUIT:
+                current.convert_suit = static_cast<int8_t>(arg);
+                converted = arg;
+                has_effect = true;
+                flush();
+                break;
+            case TarotOp::RETRIGGER:
+                current.retrigger = true;
+                has_effect = true;
+                break;
+        }
+    }
+    flush();
+}
+
+bool passes(
+    const TarotModifier &modifier,
+    const bool *passed,
+    uint16_t rank_bit,
+    uint8_t suit_bit,
+    uint16_t hand_bit,
+    int played_count
+)
+{
+    return (modifier.after < 0 || passed[modifier.after]) && (modifier.rank_mask & rank_bit) &&
+           (modifier.suit_mask & suit_bit) && (modifier.hand_mask & hand_bit) &&
+           played_count >= modifier.min_cards && played_count <= modifier.max_cards;
+}
+
+void addModifier(StageDelta &delta, const TarotModifier &modifier)
+{
+    delta.chips += modifier.chips;
+    delta.mult += modifier.mult;
+    delta.times *= modifier.times;
+    delta.retrigger |= modifier.retrigger;
+    if (delta.tarot < 0 && (modifier.chips != 0 || modifier.mult != 0))
+    {
+        delta.tarot = modifier.tarot;
+    }
+    if (delta.times_tarot < 0 && modifier.times != 1)
+    {
+        delta.times_tarot = modifier.tarot;
+    }
+}
+
+// every modifier that passes for one card, or for the hand with every rank and suit let through
+StageDelta foldModifiers(
+    const FixedList<TarotModifier, max_tarot_modifiers> &modifiers,
+    uint16_t rank_bit,
+    uint8_t suit_bit,
+    uint16_t hand_bit,
+    int played_count
+)
+{
+    StageDelta delta;
+    std::array<bool, max_tarot_modifiers> passed;
+    for (size_t i = 0; i < modifiers.size(); i++)
+    {
+        const TarotModifier &modifier = modifiers[i];
+        passed[i] = passes(modifier, passed.data(), rank_bit, suit_bit, hand_bit, played_count);
+        if (!passed[i]) continue;
+
+        addModifier(delta, modifier);
+        if (modifier.convert_suit >= 0)
+        {
+            suit_bit = 1 << modifier.convert_suit;
+        }
+    }
+    return delta;
+}
+
+} // namespace
+
+bool convertsSuit(const TarotEffects &effects, TarotId id)
+{
+    const TarotProgram &program = effects.programs[id];
+    for (int pc = 0; pc < program.length; pc++)
+    {
+        if (effects.code[program.start + pc].op == TarotOp::CONVERT_SUIT) return true;
+    }
+    return false;
+}
+
+const StageDelta &TarotPipeline::handDelta(HandType type, int played_count) const
+{
+    return hand[static_cast<int>(type)][played_count - 1];
+}
+
+const StageDelta &TarotPipeline::cardDelta(CardId id, HandType type, int played_count) const
+{
+    return card[id][static_cast<int>(type)][played_count - 1];
+}
+
+void compileTarotPipeline(
+    const TarotEffects &effects,
+    const FixedList<TarotId, max_hand_tarots> &held,
+    TarotPipeline &pipeline
+)
+{
+    pipeline.effects = &effects;
+    pipeline.held = held;
+
+    FixedList<TarotModifier, max_tarot_modifiers> hand_modifiers;
+    FixedList<TarotModifier, max_tarot_modifiers> card_modifiers;
+    ModifierList hand_list(hand_modifiers);
+    ModifierList card_list(card_modifiers);
+    // card programs that convert suits go first, so every other tarot sees the converted suit
+    // whenever it was bought
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (size_t t = 0; t < held.size(); t++)
+        {
+            const TarotProgram &program = effects.programs[held[t]];
+            bool converts = convertsSuit(effects, held[t]);
+            if (program.trigger == TarotTrigger::CARD && converts == (pass == 0))
+            {
+                compileProgram(effects, held[t], t, card_list);
+            }
+            else if (program.trigger == TarotTrigger::HAND && pass == 0)
+            {
+                compileProgram(effects, held[t], t, hand_list);
+            }
+        }
+    }
+
+    // a delta only depends on the card, the hand type and the card count, every case is worked
+    // out now and scoring looks it up
+    std::array<std::bitset<max_tarot_modifiers>, hand_type_count * max_play_cards> in_play;
+    for (int type = 0; type < hand_type_count; type++)
+    {
+        uint16_t hand_bit = 1 << type;
+        for (int count = 1; count <= max_play_cards; count++)
+        {
+            pipeline.hand[type][count - 1] =
+                foldModifiers(hand_modifiers, 0xFFFF, 0xFF, hand_bit, count);
+
+            // the hand type and count only pick which card modifiers can pass, combinations that
+            // pick the same ones get the same deltas
+            int combo = type * max_play_cards + count - 1;
+            for (size_t i = 0; i < card_modifiers.size(); i++)
+            {
+                const TarotModifier &modifier = card_modifiers[i];
+                in_play[combo][i] = (modifier.hand_mask & hand_bit) &&
+                                    count >= modifier.min_cards && count <= modifier.max_cards;
+            }
+            int same = 0;
+            while (in_play[same] != in_play[combo])
+            {
+                same++;
+            }
+
+            for (CardId id = 0; id < deck_size; id++)
+            {
+                StageDelta &delta = pipeline.card[id][type][count - 1];
+                if (same < combo)
+                {
+                    delta = pipeline.card[id][same / max_play_cards][same % max_play_cards];
+                    continue;
+                }
+                uint16_t rank_bit = 1 << static_cast<int>(cardRank(id));
+                uint8_t suit_bit = 1 << static_cast<int>(cardSuit(id));
+                delta = foldModifiers(card_modifiers, rank_bit, suit_bit, hand_bit, count);
+            }
+        }
+    }
+}
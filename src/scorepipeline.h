@@ -0,0 +1,79 @@
+#ifndef SRC_SCOREPIPELINE_H
+#define SRC_SCOREPIPELINE_H
+
+// the held tarots compiled into a flat list of modifiers, built again only when the tarots held
+// change. a modifier is one program's guards folded into masks plus what it adds, modifiers with
+// the same guards are merged. the modifiers are then folded ahead of time into one delta for
+// every hand type and card count, and for every card on top of that, so scoring is a lookup
+// whether one tarot is held or seven.
+//
+// a hand scores in fixed stages: the chips and mult of the hand programs, each card with the
+// chips and mult of the card programs, then every times_mult at once. suit conversions run
+// before the other card programs, so held order only matters between two conversions.
+
+#include "cardmanager.h"
+#include "cardtypes.h"
+#include "handevaluator.h"
+#include "tarot.h"
+#include <array>
+#include <cstdint>
+
+// a program never compiles to more modifiers than it has ops
+constexpr int max_tarot_modifiers = TarotEffects::max_code;
+
+struct TarotModifier
+{
+    uint16_t rank_mask = 0xFFFF; // bit per CardRank
+    uint8_t suit_mask = 0x0F;    // bit per CardSuits
+    uint16_t hand_mask = 0xFFFF; // bit per HandType
+    uint8_t min_cards = 0;
+    uint8_t max_cards = max_play_cards;
+    int16_t after = -1;       // modifier that has to pass first, the earlier ops of a program
+    int8_t tarot = -1;        // first held tarot folded in, for the animation
+    int8_t convert_suit = -1; // a CardSuits the card counts as for every later modifier
+    bool retrigger = false;
+    int32_t chips = 0;
+    int32_t mult = 0;
+    int32_t times = 1;
+};
+
+// what one stage adds to a hand
+struct StageDelta
+{
+    int32_t chips = 0;
+    int32_t mult = 0;
+    int32_t times = 1;
+    bool retrigger = false;
+    int8_t tarot = -1;       // held tarot shown for the chips and mult
+    int8_t times_tarot = -1; // held tarot shown for the times
+};
+
+// a delta by HandType and played card count - 1
+using StageTable = std::array<std::array<StageDelta, max_play_cards>, hand_type_count>;
+
+struct TarotPipeline
+{
+    // what it was compiled from, to tell when it's stale
+    const TarotEffects *effects = nullptr;
+    FixedList<TarotId, max_hand_tarots> held;
+
+    // hand programs
+    StageTable hand{};
+    // card programs by CardId, suit conversions already applied
+    std::array<StageTable, deck_size> card{};
+
+    const StageDelta &handDelta(HandType type, int played_count) const;
+
+    const StageDelta &cardDelta(CardId card, HandType type, int played_count) const;
+};
+
+// whether a program changes the suit later modifiers see
+bool convertsSuit(const TarotEffects &effects, TarotId id);
+
+void compileTarotPipeline(
+    const TarotEffects &effects,
+    const FixedList<TarotId, max_hand_tarots> &held,
+    TarotPipeline &pipeline
+);
+
+#endif // SRC_SCOREPIPELINE_H
@@ -0,0 +1,72 @@
+#include "sequence.h"
+#include <algorithm>
+
+void Wait::await_suspend(Sequence::Handle handle) const noexcept
+{
+    Sequence::promise_type &promise = handle.promise();
+    promise.wake_at = promise.sequencer->now() + ms;
+}
+
+Sequencer::~Sequencer()
+{
+    cancelAll();
+}
+
+uint64_t Sequencer::now() const
+{
+    return m_now;
+}
+
+void Sequencer::start(Sequence &&sequence)
+{
+    Sequence::Handle handle = sequence.m_handle;
+    sequence.m_handle = nullptr;
+    handle.promise().sequencer = this;
+    handle.resume();
+    if (handle.done())
+    {
+        handle.destroy();
+        return;
+    }
+    m_running.push_back(handle);
+}
+
+void Sequencer::advance(uint32_t ms)
+{
+    m_now += ms;
+    // sequences started while resuming land past count and wait for the next advance
+    size_t count = m_running.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        Sequence::Handle handle = m_running[i];
+        if (handle.promise().wake_at > m_now)
+        {
+            continue;
+        }
+        handle.resume();
+        if (handle.done())
+        {
+            handle.destroy();
+            m_running[i] = nullptr;
+        }
+    }
+    m_running.erase(
+        std::remove(m_running.begin(), m_running.end(), nullptr), m_running.end()
+    );
+}
+
+void Sequencer::cancelAll()
+{
+    // swapped out first, destroying a sequence may start or cancel others
+    std::vector<Sequence::Handle> running;
+    running.swap(m_running);
+    for (Sequence::Handle handle : running)
+    {
+        handle.destroy();
+    }
+}
+
+bool Sequencer::idle() const
+{
+    return m_running.empty();
+}
@@ -0,0 +1,131 @@
+#ifndef SRC_SEQUENCE_H
+#define SRC_SEQUENCE_H
+
+// timed sequences written as straight line C++20 coroutines instead of phase flags and timers.
+// a sequence suspends on `co_await Wait{ms}` and the sequencer resumes it once that much game
+// time went by. only running sequences are kept, so an idle sequencer costs nothing per step.
+//
+//   Sequence Game::scoreHand()
+//   {
+//       co_await Wait{500};
+//       ...
+//   }
+//   sequencer.start(scoreHand());
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+class Sequencer;
+
+class Sequence
+{
+public:
+    struct promise_type
+    {
+        uint64_t wake_at = 0; // sequencer time to resume at
+        Sequencer *sequencer = nullptr;
+
+        Sequence get_return_object()
+        {
+            return Sequence(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // nothing runs until the sequencer starts it
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        // stay around finished so the sequencer sees done() and destroys it
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void()
+        {
+        }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+private:
+    Handle m_handle;
+
+    friend class Sequencer;
+
+    explicit Sequence(Handle handle) : m_handle(handle)
+    {
+    }
+
+public:
+    Sequence(Sequence &&other) noexcept : m_handle(other.m_handle)
+    {
+        other.m_handle = nullptr;
+    }
+
+    Sequence(const Sequence &) = delete;
+    Sequence &operator=(const Sequence &) = delete;
+    Sequence &operator=(Sequence &&) = delete;
+
+    ~Sequence()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+};
+
+// suspend the running sequence for ms of game time, 0 waits for the next step
+struct Wait
+{
+    uint32_t ms;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(Sequence::Handle handle) const noexcept;
+
+    void await_resume() const noexcept
+    {
+    }
+};
+
+class Sequencer
+{
+private:
+    std::vector<Sequence::Handle> m_running;
+    uint64_t m_now = 0;
+
+public:
+    Sequencer() = default;
+    ~Sequencer();
+
+    Sequencer(const Sequencer &) = delete;
+    Sequencer &operator=(const Sequencer &) = delete;
+
+    uint64_t now() const;
+
+    // run the sequence up to its first wait
+    void start(Sequence &&sequence);
+
+    // move time on and resume the sequences whose wait is over
+    void advance(uint32_t ms);
+
+    // drop every running sequence where it stands, not from inside a sequence
+    void cancelAll();
+
+    bool idle() const;
+};
+
+#endif // SRC_SEQUENCE_H
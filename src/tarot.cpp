@@ -0,0 +1,265 @@
+#include "tarot.h"
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+
+enum class ArgKind
+{
+    NONE,
+    NUMBER,
+    SUIT,
+    RANK,
+    HAND
+};
+
+struct OpInfo
+{
+    std::string_view name;
+    TarotOp op;
+    ArgKind arg;
+    bool card_only; // needs a card, only in card programs
+};
+
+constexpr std::array<OpInfo, 12> op_table = {{
+    {"add_chips", TarotOp::ADD_CHIPS, ArgKind::NUMBER, false},
+    {"add_mult", TarotOp::ADD_MULT, ArgKind::NUMBER, false},
+    {"times_mult", TarotOp::TIMES_MULT, ArgKind::NUMBER, false},
+    {"if_suit", TarotOp::IF_SUIT, ArgKind::SUIT, true},
+    {"if_rank", TarotOp::IF_RANK, ArgKind::RANK, true},
+    {"if_rank_max", TarotOp::IF_RANK_MAX, ArgKind::RANK, true},
+    {"if_face", TarotOp::IF_FACE, ArgKind::NONE, true},
+    {"if_hand", TarotOp::IF_HAND, ArgKind::HAND, false},
+    {"if_min_cards", TarotOp::IF_MIN_CARDS, ArgKind::NUMBER, false},
+    {"if_max_cards", TarotOp::IF_MAX_CARDS, ArgKind::NUMBER, false},
+    {"convert_suit", TarotOp::CONVERT_SUIT, ArgKind::SUIT, true},
+    {"retrigger", TarotOp::RETRIGGER, ArgKind::NONE, true},
+}};
+
+constexpr std::array<std::string_view, 4> suit_names = {"clubs", "spades", "diamonds", "hearts"};
+
+// by TarotRarity
+constexpr std::array<std::string_view, 3> rarity_names = {"common", "uncommon", "rare"};
+
+// by hand_names order
+constexpr std::array<std::string_view, hand_type_count> hand_keys = {
+    "high_card",
+    "pair",
+    "two_pair",
+    "three_of_a_kind",
+    "straight",
+    "flush",
+    "full_house",
+    "four_of_a_kind",
+    "straight_flush",
+};
+
+std::string_view trim(std::string_view text)
+{
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos)
+    {
+        return {};
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+template <size_t N>
+int findName(const std::array<std::string_view, N> &names, std::string_view name)
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool parseNumber(std::string_view text, int &value)
+{
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+bool parseArg(ArgKind kind, std::string_view text, int &value)
+{
+    switch (kind)
+    {
+        case ArgKind::NONE:
+            value = 0;
+            return text.empty();
+        case ArgKind::NUMBER:
+            return parseNumber(text, value) && value >= INT16_MIN && value <= INT16_MAX;
+        case ArgKind::SUIT:
+            value = findName(suit_names, text);
+            return value >= 0;
+        case ArgKind::RANK:
+        {
+            constexpr std::array<std::string_view, 4> faces = {"jack", "queen", "king", "ace"};
+            int face = findName(faces, text);
+            if (face >= 0)
+            {
+                value = static_cast<int>(CardRank::JACK) + face;
+                return true;
+            }
+            return parseNumber(text, value) && value >= 2 && value <= 14;
+        }
+        case ArgKind::HAND:
+            value = findName(hand_keys, text);
+            return value >= 0;
+    }
+    return false;
+}
+
+} // namespace
+
+int findTarot(std::string_view name)
+{
+    return findName(tarot_names, name);
+}
+
+bool parseTarotEffects(std::string_view text, TarotEffects &effects, std::string &error)
+{
+    effects = TarotEffects();
+    std::string description; // the comment right above a tarot describes it
+    int line_number = 0;
+    while (!text.empty())
+    {
+        size_t end = text.find('\n');
+        std::string_view line = trim(text.substr(0, end));
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        line_number++;
+
+        auto fail = [&](const std::string &message) {
+            error = "line " + std::to_string(line_number) + ": " + message;
+            return false;
+        };
+
+        if (line.empty())
+        {
+            description.clear();
+            continue;
+        }
+        if (line[0] == '#')
+        {
+            description = trim(line.substr(1));
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos)
+        {
+            return fail("expected <name> <trigger> [rarity]: <program>");
+        }
+        std::string_view head = trim(line.substr(0, colon));
+        size_t space = head.find_first_of(" \t");
+        if (space == std::string_view::npos)
+        {
+            return fail("expected <name> <trigger> [rarity]: <program>");
+        }
+        std::string_view name = head.substr(0, space);
+        std::string_view trigger_name = trim(head.substr(space));
+        std::string_view rarity_name = "common";
+        size_t rarity_space = trigger_name.find_first_of(" \t");
+        if (rarity_space != std::string_view::npos)
+        {
+            rarity_name = trim(trigger_name.substr(rarity_space));
+            trigger_name = trigger_name.substr(0, rarity_space);
+        }
+
+        int id = findTarot(name);
+        if (id < 0)
+        {
+            return fail("no tarot named " + std::string(name));
+        }
+        TarotProgram &program = effects.programs[id];
+        if (program.trigger != TarotTrigger::NONE)
+        {
+            return fail(std::string(name) + " has a program already");
+        }
+        if (trigger_name == "card")
+        {
+            program.trigger = TarotTrigger::CARD;
+        }
+        else if (trigger_name == "hand")
+        {
+            program.trigger = TarotTrigger::HAND;
+        }
+        else
+        {
+            return fail("trigger must be card or hand");
+        }
+        int rarity = findName(rarity_names, rarity_name);
+        if (rarity < 0)
+        {
+            return fail("rarity must be common, uncommon or rare");
+        }
+        effects.rarities[id] = static_cast<TarotRarity>(rarity);
+
+        program.start = static_cast<uint8_t>(effects.code_size);
+        std::string_view body = line.substr(colon + 1);
+        while (!body.empty())
+        {
+            size_t semicolon = body.find(';');
+            std::string_view statement = trim(body.substr(0, semicolon));
+            body = semicolon == std::string_view::npos ? std::string_view()
+                                                       : body.substr(semicolon + 1);
+            if (statement.empty()) continue;
+
+            size_t split = statement.find_first_of(" \t");
+            std::string_view op_name = statement.substr(0, split);
+            std::string_view arg = split == std::string_view::npos
+                                       ? std::string_view()
+                                       : trim(statement.substr(split));
+
+            const OpInfo *info = nullptr;
+            for (const OpInfo &entry : op_table)
+            {
+                if (entry.name == op_name) info = &entry;
+            }
+            if (!info)
+            {
+                return fail("unknown op " + std::string(op_name));
+            }
+            if (info->card_only && program.trigger != TarotTrigger::CARD)
+            {
+                return fail(std::string(op_name) + " needs a card trigger");
+            }
+            int value;
+            if (!parseArg(info->arg, arg, value))
+            {
+                return fail("bad argument for " + std::string(op_name));
+            }
+            if (effects.code_size >= TarotEffects::max_code)
+            {
+                return fail("more than " + std::to_string(TarotEffects::max_code) + " ops");
+            }
+            effects.code[effects.code_size++] = {info->op, static_cast<int16_t>(value)};
+            program.length++;
+        }
+        effects.descriptions[id] = description;
+        description.clear();
+    }
+    return true;
+}
+
+bool loadTarotEffects(const std::string &path, TarotEffects &effects, std::string &error)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        error = "couldn't open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    if (!parseTarotEffects(text, effects, error))
+    {
+        error = path + " " + error;
+        return false;
+    }
+    return true;
+}
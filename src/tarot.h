@@ -0,0 +1,126 @@
+#ifndef SRC_TAROT_H
+#define SRC_TAROT_H
+
+// tarot effects as tiny programs loaded from a data file, without SDL so headless runs use them.
+// every tarot has one program, a few typed instructions compiled into the scoring pipeline
+// (scorepipeline.h). guards (the if_ opcodes) end the program when they fail, so a program
+// reads as "if this and that, then add this".
+//
+// data file, one tarot per line, # starts a comment:
+//   <name> <trigger> [rarity]: <op> [arg]; <op> [arg]; ...
+// trigger is `card`, run for every scored card, or `hand`, run once before the cards.
+// every times_mult, from either, applies after the cards.
+// rarity is `common` (the default), `uncommon` or `rare`, it sets how often a tarot is offered.
+
+#include "cardtypes.h"
+#include "handevaluator.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+constexpr int tarot_count = 22;
+constexpr int max_showed_tarots = 3;
+constexpr int max_hand_tarots = 6;
+
+// coins to take an offered tarot, and what selling one gives back
+constexpr int tarot_price = 3;
+constexpr int tarot_sell_price = 1;
+
+// index into tarot_names
+using TarotId = uint8_t;
+
+// the names of the tarot atlas, in id order
+constexpr std::array<std::string_view, tarot_count> tarot_names = {
+    "chariot",
+    "death",
+    "emperor",
+    "empress",
+    "hanged_man",
+    "hierophant",
+    "judgement",
+    "justice",
+    "magician",
+    "priestess",
+    "strength",
+    "temperance",
+    "the_devil",
+    "the_fool",
+    "the_hermit",
+    "the_lovers",
+    "the_moon",
+    "the_star",
+    "the_sun",
+    "the_tower",
+    "the_world",
+    "wheel_of_fortune",
+};
+
+enum class TarotRarity : uint8_t
+{
+    COMMON,
+    UNCOMMON,
+    RARE
+};
+
+// offer odds by TarotRarity
+constexpr std::array<uint32_t, 3> rarity_weights = {60, 30, 10};
+
+enum class TarotTrigger : uint8_t
+{
+    NONE, // no program, the tarot does nothing
+    CARD,
+    HAND
+};
+
+enum class TarotOp : uint8_t
+{
+    ADD_CHIPS,    // arg chips
+    ADD_MULT,     // arg mult
+    TIMES_MULT,   // mult times arg, after every additive mult
+    IF_SUIT,      // card: arg is a CardSuits
+    IF_RANK,      // card: arg is a CardRank
+    IF_RANK_MAX,  // card: rank at most arg
+    IF_FACE,      // card: jack, queen or king
+    IF_HAND,      // arg is the HandType played
+    IF_MIN_CARDS, // at least arg cards played
+    IF_MAX_CARDS, // at most arg cards played
+    CONVERT_SUIT, // card: counts as suit arg for every following guard
+    RETRIGGER,    // card: scores once more, at most once per card
+};
+
+struct TarotInstruction
+{
+    TarotOp op;
+    int16_t arg = 0;
+};
+
+struct TarotProgram
+{
+    TarotTrigger trigger = TarotTrigger::NONE;
+    uint8_t start = 0; // into TarotEffects::code
+    uint8_t length = 0;
+};
+
+// every program back to back in one array, loaded once and shared by all runs
+struct TarotEffects
+{
+    static constexpr int max_code = 255;
+
+    std::array<TarotProgram, tarot_count> programs{};
+    std::array<TarotRarity, tarot_count> rarities{};
+    std::array<TarotInstruction, max_code> code{};
+    int code_size = 0;
+    std::array<std::string, tarot_count> descriptions; // for the player, from the comment above
+};
+
+// false with a message naming the line when the file doesn't parse
+bool loadTarotEffects(const std::string &path, TarotEffects &effects, std::string &error);
+
+// parse from memory, for the loader and tools
+bool parseTarotEffects(std::string_view text, TarotEffects &effects, std::string &error);
+
+// the tarot name in the atlas, -1 if there is no such tarot
+int findTarot(std::string_view name);
+
+#endif // SRC_TAROT_H
@@ -0,0 +1,226 @@
+#include "textatlas.h"
+#include <SDL3/SDL_log.h>
+
+TextAtlas *TextAtlas::instance()
+{
+    static TextAtlas instance;
+    return &instance;
+}
+
+TextAtlas::~TextAtlas()
+{
+    clear();
+}
+
+bool TextAtlas::isValid(const TextSlot &slot) const
+{
+    return slot.index >= 0 && slot.index < static_cast<int>(m_slots.size()) &&
+           m_slots[slot.index].in_use && m_slots[slot.index].generation == slot.generation;
+}
+
+bool TextAtlas::reserve(SDL_Renderer *renderer, TextSlot &slot, int w, int h)
+{
+    if (isValid(slot))
+    {
+        const SDL_Rect &rect = m_slots[slot.index].rect;
+        if (w <= rect.w && h <= rect.h)
+        {
+            return true;
+        }
+        release(slot);
+    }
+    if (w > page_size || h > page_size)
+    {
+        return false;
+    }
+
+    // a freed slot that fits, else new space on a shelf, else make room
+    int index = takeFree(w, h);
+    bool was_reset = false;
+    while (index < 0)
+    {
+        Slot fresh;
+        if (allocateOnShelf(renderer, w, h, fresh))
+        {
+            index = static_cast<int>(m_slots.size());
+            m_slots.push_back(fresh);
+        }
+        else if (evictOldest())
+        {
+            index = takeFree(w, h);
+        }
+        else if (!was_reset)
+        {
+            // nothing left to evict and the free rects are too small, start the pages over
+            reset();
+            was_reset = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    Slot &taken = m_slots[index];
+    taken.in_use = true;
+    taken.generation = ++m_generation;
+    taken.last_used = ++m_clock;
+    slot.index = index;
+    slot.generation = taken.generation;
+    return true;
+}
+
+void TextAtlas::release(TextSlot &slot)
+{
+    if (isValid(slot))
+    {
+        m_slots[slot.index].in_use = false;
+        m_free.push_back(slot.index);
+    }
+    slot = TextSlot();
+}
+
+void TextAtlas::touch(const TextSlot &slot)
+{
+    if (isValid(slot))
+    {
+        m_slots[slot.index].last_used = ++m_clock;
+    }
+}
+
+SDL_Texture *TextAtlas::getTexture(const TextSlot &slot) const
+{
+    return m_pages[m_slots[slot.index].page].texture;
+}
+
+SDL_Point TextAtlas::getOrigin(const TextSlot &slot) const
+{
+    const SDL_Rect &rect = m_slots[slot.index].rect;
+    return {rect.x, rect.y};
+}
+
+void TextAtlas::reset()
+{
+    for (Page &page : m_pages)
+    {
+        page.shelves.clear();
+        page.bottom = 0;
+    }
+    m_slots.clear();
+    m_free.clear();
+}
+
+void TextAtlas::clear()
+{
+    for (Page &page : m_pages)
+    {
+        if (page.texture)
+        {
+            SDL_DestroyTexture(page.texture);
+        }
+    }
+    m_pages.clear();
+    m_slots.clear();
+    m_free.clear();
+}
+
+int TextAtlas::takeFree(int w, int h)
+{
+    // the smallest freed rect that fits wastes the least
+    int best = -1;
+    int best_area = 0;
+    for (size_t i = 0; i < m_free.size(); i++)
+    {
+        const SDL_Rect &rect = m_slots[m_free[i]].rect;
+        int area = rect.w * rect.h;
+        if (w <= rect.w && h <= rect.h && (best < 0 || area < best_area))
+        {
+            best = static_cast<int>(i);
+            best_area = area;
+        }
+    }
+    if (best < 0)
+    {
+        return -1;
+    }
+    int index = m_free[best];
+    m_free[best] = m_free.back();
+    m_free.pop_back();
+    return index;
+}
+
+bool TextAtlas::allocateOnShelf(SDL_Renderer *renderer, int w, int h, Slot &slot)
+{
+    int padded_w = w + padding;
+    int padded_h = h + padding;
+    for (size_t p = 0; p <= m_pages.size() && p < max_pages; p++)
+    {
+        if (p == m_pages.size())
+        {
+            Page page;
+            page.texture = SDL_CreateTexture(
+                renderer,
+                SDL_PIXELFORMAT_RGBA8888,
+                SDL_TEXTUREACCESS_TARGET,
+                page_size,
+                page_size
+            );
+            if (!page.texture)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create a text atlas page");
+                return false;
+            }
+            SDL_SetTextureScaleMode(page.texture, SDL_SCALEMODE_PIXELART);
+            m_pages.push_back(page);
+        }
+
+        // the lowest shelf it fits on, not much taller than the text so little goes to waste
+        Page &page = m_pages[p];
+        Shelf *best = nullptr;
+        for (Shelf &shelf : page.shelves)
+        {
+            bool fits = shelf.height >= padded_h && shelf.x + padded_w <= page_size;
+            if (fits && shelf.height <= padded_h * 2 && (!best || shelf.height < best->height))
+            {
+                best = &shelf;
+            }
+        }
+        if (!best && page.bottom + padded_h <= page_size && padded_w <= page_size)
+        {
+            page.shelves.push_back({page.bottom, padded_h});
+            page.bottom += padded_h;
+            best = &page.shelves.back();
+        }
+        if (!best)
+        {
+            continue;
+        }
+
+        slot.page = static_cast<int>(p);
+        slot.rect = {best->x, best->y, w, h};
+        best->x += padded_w;
+        return true;
+    }
+    return false;
+}
+
+bool TextAtlas::evictOldest()
+{
+    int oldest = -1;
+    for (size_t i = 0; i < m_slots.size(); i++)
+    {
+        const Slot &slot = m_slots[i];
+        if (slot.in_use && (oldest < 0 || slot.last_used < m_slots[oldest].last_used))
+        {
+            oldest = static_cast<int>(i);
+        }
+    }
+    if (oldest < 0)
+    {
+        return false;
+    }
+    // its text finds the slot gone and reserves again on its next draw
+    m_slots[oldest].in_use = false;
+    m_free.push_back(oldest);
+    return true;
+}
@@ -0,0 +1,89 @@
+#ifndef SRC_TEXTATLAS_H
+#define SRC_TEXTATLAS_H
+
+// one cache for every rendered Text: a few large render target pages, packed in shelves.
+// a text keeps its slot while it still fits, so a counter that changes every tick draws into
+// the same rect instead of creating and destroying a texture. when the pages are full the least
+// recently drawn slots are evicted, their texts render again into a new slot on their next draw.
+
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <cstdint>
+#include <vector>
+
+// what a Text holds on to, checked against the atlas before every draw
+struct TextSlot
+{
+    int index = -1;
+    uint32_t generation = 0; // of the reservation, a slot taken again gets a new one
+};
+
+class TextAtlas
+{
+public:
+    static constexpr int page_size = 1024;
+    static constexpr int max_pages = 4;
+    static constexpr int padding = 1; // between slots, so nothing bleeds into a neighbour
+
+private:
+    struct Shelf
+    {
+        int y;
+        int height;
+        int x = 0; // where the next slot on it goes
+    };
+
+    struct Page
+    {
+        SDL_Texture *texture = nullptr;
+        std::vector<Shelf> shelves;
+        int bottom = 0; // top of the next shelf
+    };
+
+    struct Slot
+    {
+        int page = 0;
+        SDL_Rect rect = {}; // the space it takes, the text can be smaller
+        uint32_t generation = 0; // of the text holding it
+        uint64_t last_used = 0;
+        bool in_use = false;
+    };
+
+    std::vector<Page> m_pages;
+    std::vector<Slot> m_slots;
+    std::vector<int> m_free; // slots not in use, their rects are taken again by texts that fit
+    uint64_t m_clock = 0;    // counts draws, for least recently used
+    uint32_t m_generation = 0; // never repeats, so a stale TextSlot can't match a new reservation
+
+    bool allocateOnShelf(SDL_Renderer *renderer, int w, int h, Slot &slot);
+    int takeFree(int w, int h);
+    bool evictOldest();
+    // forget every slot and shelf, the pages stay
+    void reset();
+
+public:
+    static TextAtlas *instance();
+
+    ~TextAtlas();
+
+    bool isValid(const TextSlot &slot) const;
+
+    // a valid slot that still fits keeps its place, anything else gets a new one.
+    // false when the text is larger than a page.
+    bool reserve(SDL_Renderer *renderer, TextSlot &slot, int w, int h);
+
+    void release(TextSlot &slot);
+
+    // mark the slot as just drawn
+    void touch(const TextSlot &slot);
+
+    SDL_Texture *getTexture(const TextSlot &slot) const;
+
+    // top left corner of the slot in its page
+    SDL_Point getOrigin(const TextSlot &slot) const;
+
+    // destroy every page, before the renderer goes away
+    void clear();
+};
+
+#endif // SRC_TEXTATLAS_H
@@ -78,7 +78,11 @@ bool Font::initialize(SDL_Renderer *renderer, const std::string &fntPath)
                 else if (key == "yoffset") g.yoffset = std::stof(val);
                 else if (key == "xadvance") g.advance = std::stof(val);
             }
-            if (id >= 0) glyphs[id] = g;
+            if (id >= 0 && id < static_cast<int>(glyphs.size()))
+            {
+                glyphs[id] = g;
+                has_glyph.set(id);
+            }
         }
     }
 
@@ -86,9 +90,85 @@ bool Font::initialize(SDL_Renderer *renderer, const std::string &fntPath)
     std::string texturePath = fntPath.substr(0, fntPath.find_last_of("/\\") + 1) + textureFile;
     texture = IMG_LoadTexture(renderer, texturePath.c_str());
     SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_PIXELART);
+    SDL_GetTextureSize(texture, &texture_width, &texture_height);
     return true;
 }
 
+void GlyphBatch::clear()
+{
+    m_vertices.clear();
+    m_indices.clear();
+}
+
+bool GlyphBatch::empty() const
+{
+    return m_indices.empty();
+}
+
+void GlyphBatch::addGlyph(
+    const Font &font,
+    const GlyphInfo &glyph,
+    float x,
+    float y,
+    SDL_FColor color
+)
+{
+    float u0 = glyph.rect.x / font.texture_width;
+    float v0 = glyph.rect.y / font.texture_height;
+    float u1 = (glyph.rect.x + glyph.rect.w) / font.texture_width;
+    float v1 = (glyph.rect.y + glyph.rect.h) / font.texture_height;
+    float w = static_cast<float>(glyph.rect.w);
+    float h = static_cast<float>(glyph.rect.h);
+
+    int first = static_cast<int>(m_vertices.size());
+    m_vertices.push_back({{x, y}, color, {u0, v0}});
+    m_vertices.push_back({{x + w, y}, color, {u1, v0}});
+    m_vertices.push_back({{x + w, y + h}, color, {u1, v1}});
+    m_vertices.push_back({{x, y + h}, color, {u0, v1}});
+    for (int corner : {0, 1, 2, 0, 2, 3})
+    {
+        m_indices.push_back(first + corner);
+    }
+}
+
+void GlyphBatch::setColor(SDL_FColor color)
+{
+    for (SDL_Vertex &vertex : m_vertices)
+    {
+        vertex.color = color;
+    }
+}
+
+void GlyphBatch::draw(SDL_Renderer *renderer, SDL_Texture *texture) const
+{
+    if (empty()) return;
+
+    SDL_RenderGeometry(
+        renderer,
+        texture,
+        m_vertices.data(),
+        static_cast<int>(m_vertices.size()),
+        m_indices.data(),
+        static_cast<int>(m_indices.size())
+    );
+}
+
+void GlyphBatch::drawOutlines(SDL_Renderer *renderer) const
+{
+    for (size_t i = 0; i + 3 < m_vertices.size(); i += 4)
+    {
+        SDL_FPoint top_left = m_vertices[i].position;
+        SDL_FPoint bottom_right = m_vertices[i + 2].position;
+        SDL_FRect rect = {
+            top_left.x,
+            top_left.y,
+            bottom_right.x - top_left.x,
+            bottom_right.y - top_left.y
+        };
+        SDL_RenderRect(renderer, &rect);
+    }
+}
+
 Font *FontsManager::getFont(const std::string &id)
 {
     auto it = fonts.find(id);
@@ -118,10 +198,7 @@ Text::Text(Font *font, const char *text, float max_width, float scale, SDL_Color
 
 Text::~Text()
 {
-    if (m_cached_texture)
-    {
-        SDL_DestroyTexture(m_cached_texture);
-    }
+    TextAtlas::instance()->release(m_slot);
 }
 
 SDL_FRect Text::getRect()
@@ -134,19 +211,20 @@ void Text::recalculateBoundingRect()
     int x = 4, y = 0;
     int maxlineWidth = 0;
     int lineHeight = m_font->line_height;
+    SDL_FColor color = {m_color.r / 255.0f, m_color.g / 255.0f, m_color.b / 255.0f, 1.0f};
+    m_batch.clear();
     std::stringstream ss(m_text);
     std::string word;
-    auto it = m_font->glyphs.find(' ');
-    GlyphInfo &space = it->second;
+    // all zero when the font has no space
+    const GlyphInfo &space = m_font->glyphs[' '];
     while (ss >> word)
     {
         int wordWidth = 0;
         for (char c : word)
         {
-            auto it = m_font->glyphs.find(c);
-            if (it == m_font->glyphs.end()) continue;
-            GlyphInfo &glyph = it->second;
-            wordWidth += glyph.advance + glyph.xoffset + 2;
+            const GlyphInfo *glyph = m_font->getGlyph(c);
+            if (!glyph) continue;
+            wordWidth += glyph->advance + glyph->xoffset + 2;
         }
 
         // plus space after word
@@ -159,6 +237,15 @@ void Text::recalculateBoundingRect()
             x = 4;
         }
 
+        int glyphX = x;
+        for (char c : word)
+        {
+            const GlyphInfo *glyph = m_font->getGlyph(c);
+            if (!glyph) continue;
+            m_batch.addGlyph(*m_font, *glyph, glyphX, y + glyph->yoffset, color);
+            glyphX += glyph->advance + glyph->xoffset + 2;
+        }
+
         x += wordWidth;
         maxlineWidth = std::max(maxlineWidth, x);
     }
@@ -188,6 +275,7 @@ void Text::setColor(float r, float g, float b)
     m_color.r = r;
     m_color.g = g;
     m_color.b = b;
+    m_batch.setColor({m_color.r / 255.0f, m_color.g / 255.0f, m_color.b / 255.0f, 1.0f});
     m_dirty = true;
 }
 
@@ -210,85 +298,50 @@ void Text::renderText(SDL_Renderer *renderer, bool centered)
         dst_rect.x -= m_text_rect.w * 0.5;
         dst_rect.y -= m_text_rect.h * 0.5;
     }
-    if (m_dirty)
+    int width = static_cast<int>(m_text_rect.w);
+    int height = static_cast<int>(m_text_rect.h);
+    if (width <= 0 || height <= 0)
     {
-        if (m_cached_texture)
+        return;
+    }
+
+    TextAtlas *atlas = TextAtlas::instance();
+    if (m_dirty || !atlas->isValid(m_slot))
+    {
+        // same slot while the text still fits in it, a new one otherwise
+        if (!atlas->reserve(renderer, m_slot, width, height))
         {
-            SDL_DestroyTexture(m_cached_texture);
-            m_cached_texture = nullptr;
+            return;
         }
-        m_cached_texture = SDL_CreateTexture(
-            renderer,
-            SDL_PIXELFORMAT_RGBA8888,
-            SDL_TEXTUREACCESS_TARGET,
-            static_cast<int>(m_text_rect.w),
-            static_cast<int>(m_text_rect.h)
-        );
-        SDL_SetTextureScaleMode(m_cached_texture, SDL_SCALEMODE_PIXELART);
-        SDL_SetRenderTarget(renderer, m_cached_texture);
-        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0); // Clear
-        SDL_RenderClear(renderer);
-
-        float cursorX = 4;
-        float cursorY = 0;
-        std::istringstream iss(m_text);
-        std::string word;
-
-        auto it = m_font->glyphs.find(' ');
-        GlyphInfo &space = it->second;
-
-        int lineHeight = m_font->line_height;
-        while (iss >> word)
-        {
-            int wordWidth = 0;
-            for (char c : word)
-            {
-                auto it = m_font->glyphs.find(c);
-                if (it == m_font->glyphs.end()) continue;
-                GlyphInfo &info = it->second;
-                wordWidth += info.advance + info.xoffset + 2;
-            }
-
-            wordWidth += space.advance + space.xoffset;
-
-            if (m_max_width > 0 && cursorX + wordWidth > m_max_width)
-            {
-                cursorX = 4;
-                cursorY += lineHeight;
-            }
-
-            for (char c : word)
-            {
-                auto it = m_font->glyphs.find(c);
-                if (it == m_font->glyphs.end()) continue;
-                GlyphInfo &info = it->second;
-
-                SDL_FRect gyph_src_rect, glyph_dst_rect;
-                SDL_RectToFRect(&info.rect, &gyph_src_rect);
-                glyph_dst_rect.x = cursorX;
-                glyph_dst_rect.y = cursorY + static_cast<float>(info.yoffset);
-                glyph_dst_rect.w = static_cast<float>(info.rect.w);
-                glyph_dst_rect.h = static_cast<float>(info.rect.h);
-
-                SDL_SetTextureColorModFloat(m_cached_texture, m_color.r, m_color.g, m_color.b);
-                SDL_RenderTexture(renderer, m_font->texture, &gyph_src_rect, &glyph_dst_rect);
+        SDL_Point origin = atlas->getOrigin(m_slot);
+        SDL_Rect area = {origin.x, origin.y, width, height};
+        SDL_SetRenderTarget(renderer, atlas->getTexture(m_slot));
+        SDL_SetRenderViewport(renderer, &area);
+        // overwrite what the slot held before, the page is shared so no RenderClear
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(renderer, nullptr);
+
+        // every glyph in one draw call, laid out when the text changed
+        m_batch.draw(renderer, m_font->texture);
 #if DEBUG_LAYOUT
-                SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-                SDL_RenderRect(renderer, &glyph_dst_rect);
+        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
+        m_batch.drawOutlines(renderer);
 #endif
-                cursorX += info.advance + info.xoffset + 2;
-            }
-            // add space
-            cursorX += space.advance + space.xoffset;
-        }
+        SDL_SetRenderViewport(renderer, nullptr);
         SDL_SetRenderTarget(renderer, nullptr);
-        SDL_RenderTexture(renderer, m_cached_texture, nullptr, &dst_rect);
         m_dirty = false;
     }
-    else
-    {
-        SDL_RenderTexture(renderer, m_cached_texture, nullptr, &dst_rect);
-    }
+
+    atlas->touch(m_slot);
+    SDL_Point origin = atlas->getOrigin(m_slot);
+    SDL_FRect src_rect = {
+        static_cast<float>(origin.x),
+        static_cast<float>(origin.y),
+        static_cast<float>(width),
+        static_cast<float>(height)
+    };
+    SDL_RenderTexture(renderer, atlas->getTexture(m_slot), &src_rect, &dst_rect);
 #if DEBUG_LAYOUT
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
     SDL_RenderRect(renderer, &dst_rect);
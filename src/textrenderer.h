@@ -2,9 +2,13 @@
 #define SRC_TEXTRENDERER_H
 
 #include <SDL3/SDL_rect.h>
+#include "textatlas.h"
 #include <SDL3/SDL_render.h>
+#include <array>
+#include <bitset>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 struct GlyphInfo
 {
@@ -20,7 +24,11 @@ class Font
 public:
     int line_height;
     SDL_Texture *texture;
-    std::unordered_map<char, GlyphInfo> glyphs;
+    float texture_width = 1; // to turn glyph rects into texture coordinates
+    float texture_height = 1;
+    // indexed by the byte value, a lookup is a single load
+    std::array<GlyphInfo, 256> glyphs{};
+    std::bitset<256> has_glyph;
 
     Font(SDL_Renderer *renderer, const std::string &fntPath);
     Font() = default;
@@ -32,6 +40,38 @@ public:
 
     // load the font bitmap information
     bool initialize(SDL_Renderer *renderer, const std::string &fntPath);
+
+    // null when the font has no glyph for c
+    const GlyphInfo *getGlyph(char c) const
+    {
+        unsigned char index = static_cast<unsigned char>(c);
+        return has_glyph[index] ? &glyphs[index] : nullptr;
+    }
+};
+
+// glyph quads of one font texture with the color in the vertices, drawn with one
+// SDL_RenderGeometry however many glyphs there are. cleared and refilled, the arrays keep their
+// capacity.
+class GlyphBatch
+{
+private:
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+public:
+    void clear();
+
+    bool empty() const;
+
+    void addGlyph(const Font &font, const GlyphInfo &glyph, float x, float y, SDL_FColor color);
+
+    // recolor every glyph without laying them out again
+    void setColor(SDL_FColor color);
+
+    void draw(SDL_Renderer *renderer, SDL_Texture *texture) const;
+
+    // quad outlines, for DEBUG_LAYOUT
+    void drawOutlines(SDL_Renderer *renderer) const;
 };
 
 class FontsManager
@@ -54,7 +94,8 @@ private:
     SDL_FRect m_text_rect;
     float m_scale;
     SDL_Color m_color;
-    SDL_Texture *m_cached_texture = nullptr;
+    TextSlot m_slot; // where the rendered text is cached in the TextAtlas
+    GlyphBatch m_batch; // laid out with the bounding rect, relative to the text
     bool m_dirty = true;
     float m_max_width = 0;
     float m_x = 0;
@@ -75,6 +116,7 @@ public:
 
     SDL_FRect getRect();
 
+    // lay the glyphs out into the batch and measure them, in one pass
     void recalculateBoundingRect();
 
     void setScale(float scale);
@@ -1,10 +1,10 @@
 #include "widget.h"
-#include "SDL3/SDL_timer.h"
 #include "layout.h"
 #include "textrenderer.h"
 #include <SDL3/SDL_pixels.h>
 #include <SDL3/SDL_rect.h>
 #include <SDL3/SDL_render.h>
+#include <cmath>
 
 void Widget::draw(SDL_Renderer *renderer)
 {
@@ -103,7 +103,7 @@ bool WidgetClickable::checkClick(SDL_FPoint mouse)
 {
     if (SDL_PointInRectFloat(&mouse, &m_rect))
     {
-        m_last_click = SDL_GetTicks();
+        m_click_elapsed = 0;
         m_clicked = !m_clicked;
         m_mouse = mouse;
         return true;
@@ -155,9 +155,14 @@ void WidgetClickable::clickLeave()
 
 void WidgetClickable::update(float dt)
 {
-    if (m_clicked && SDL_GetTicks() - m_last_click > m_delay_click)
+    // dt comes in fixed clock steps, so the delay is the same at any frame rate
+    if (m_clicked)
     {
-        m_last_click = 0;
+        m_click_elapsed += static_cast<int>(std::lround(dt * 1000));
+    }
+    if (m_clicked && m_click_elapsed > m_delay_click)
+    {
+        m_click_elapsed = 0;
         doClick();
         m_clicked = false;
     }
@@ -187,6 +192,13 @@ Button::Button(WidgetLayout *parent, Text &&text_renderer, Float4 padding)
     setBoundingRect(m_text_renderer.getRect());
 }
 
+void Button::setText(const char *text)
+{
+    m_text_renderer.setText(text);
+    setBoundingRect(m_text_renderer.getRect());
+    m_parent->recalculateBoundingRect();
+}
+
 void Button::clickEnter()
 {
     WidgetClickable::clickEnter();
@@ -266,10 +278,11 @@ PrimaryButton::PrimaryButton(
     setClickTexture(atlas->getAtlas(), atlas->getTextureInfo(texture_name + "-clicked").rect);
 }
 
-CardWidget::CardWidget(WidgetLayout *parent, Card *card)
-    : m_card(card), m_text_renderer(FontsManager::getFont("font1-w"), "")
+CardWidget::CardWidget(WidgetLayout *parent, const Card *card)
+    : m_text_renderer(FontsManager::getFont("font1-w"), "")
 {
     m_parent = parent;
+    setCard(card);
     m_delay_click = 100;
 
     float card_width = 57 * 2;
@@ -280,20 +293,20 @@ CardWidget::CardWidget(WidgetLayout *parent, Card *card)
 
 void CardWidget::clickLeave()
 {
-    if (!m_card)
+    if (!m_atlas)
     {
         return;
     }
-    if (m_card->selected && !m_was_selected)
+    if (m_selected && !m_was_selected)
     {
         m_rect.y -= 20;
     }
-    else if (!m_card->selected && m_was_selected)
+    else if (!m_selected && m_was_selected)
     {
         m_rect.y += 20;
     }
 
-    m_was_selected = m_card->selected;
+    m_was_selected = m_selected;
 }
 
 void CardWidget::resetPosition()
@@ -303,17 +316,40 @@ void CardWidget::resetPosition()
         m_rect.y += 20;
         m_was_selected = false;
     }
+    m_selected = false;
 }
 
-void CardWidget::setCard(Card *card)
+void CardWidget::setCard(const Card *card)
 {
-    m_card = card;
-    if (m_card != nullptr)
+    if (card == nullptr)
     {
-        m_text_renderer.setText(
-            std::string("+" + std::to_string(static_cast<int>(card->rank))).c_str()
-        );
+        m_atlas = nullptr;
+        return;
+    }
+    m_atlas = card->atlas;
+    m_tex_rect = card->tex_rect;
+    m_text_renderer.setText(std::string("+" + std::to_string(getCardChips(card->rank))).c_str());
+}
+
+void CardWidget::setTarot(const Tarot *tarot)
+{
+    if (tarot == nullptr)
+    {
+        m_atlas = nullptr;
+        return;
     }
+    m_atlas = tarot->atlas;
+    m_tex_rect = tarot->tex_rect;
+}
+
+void CardWidget::setScoreText(const char *text)
+{
+    m_text_renderer.setText(text);
+}
+
+void CardWidget::setSelected(bool selected)
+{
+    m_selected = selected;
 }
 
 void CardWidget::setRenderScore(bool render_score)
@@ -321,11 +357,16 @@ void CardWidget::setRenderScore(bool render_score)
     m_render_score = render_score;
 }
 
+void CardWidget::setSuggested(bool suggested)
+{
+    m_suggested = suggested;
+}
+
 void CardWidget::draw(SDL_Renderer *renderer)
 {
-    if (m_card != nullptr)
+    if (m_atlas != nullptr)
     {
-        SDL_RenderTexture(renderer, m_card->atlas, &m_card->tex_rect, &m_rect);
+        SDL_RenderTexture(renderer, m_atlas, &m_tex_rect, &m_rect);
     }
     else
     {
@@ -335,6 +376,17 @@ void CardWidget::draw(SDL_Renderer *renderer)
         SDL_RenderRect(renderer, &m_rect);
     }
 
+    if (m_suggested)
+    {
+        SDL_FRect outline = {m_rect.x - 3, m_rect.y - 3, m_rect.w + 6, m_rect.h + 6};
+        SDL_SetRenderDrawColor(renderer, 255, 215, 0, 255);
+        for (int i = 0; i < 3; i++)
+        {
+            SDL_RenderRect(renderer, &outline);
+            outline = {outline.x + 1, outline.y + 1, outline.w - 2, outline.h - 2};
+        }
+    }
+
     if (m_render_score)
     {
         m_text_renderer.setPosition(m_rect.x + m_rect.w * 0.5, m_rect.y - 20);
@@ -51,6 +51,12 @@ public:
         return false;
     }
 
+    // whether a click on it does something, without clicking it
+    virtual bool isClickable()
+    {
+        return false;
+    }
+
     virtual void draw(SDL_Renderer *renderer);
 
     virtual void update(float dt)
@@ -72,7 +78,7 @@ protected:
     SDL_Texture *m_click_texture = nullptr;
     SDL_FRect m_click_tex_rect;
     std::function<void(SDL_FPoint)> m_callback;
-    unsigned int m_last_click = 0;
+    int m_click_elapsed = 0; // ms of game time since the click
     bool m_clicked = false;
     bool m_was_clicked = false;
     int m_delay_click = 150;
@@ -82,6 +88,10 @@ public:
     void setClickColor(SDL_Color color);
     void setClickTexture(SDL_Texture *texture, SDL_FRect rect);
     bool checkClick(SDL_FPoint mouse) override;
+    bool isClickable() override
+    {
+        return true;
+    }
     void doClick();
     virtual void clickEnter();
     virtual void clickLeave();
@@ -107,6 +117,7 @@ public:
 
     ~Button() = default;
 
+    void setText(const char *text);
     void setRect(SDL_FRect rect) override;
     void draw(SDL_Renderer *renderer) override;
     void clickEnter() override;
@@ -155,13 +166,17 @@ public:
 class CardWidget : public WidgetClickable
 {
 private:
-    Card *m_card;
+    // what the widget shows, a card or a tarot, nothing when the atlas is null
+    SDL_Texture *m_atlas = nullptr;
+    SDL_FRect m_tex_rect = {};
+    bool m_selected = false;
     bool m_was_selected = false;
     bool m_render_score = false;
+    bool m_suggested = false;
     Text m_text_renderer;
 
 public:
-    CardWidget(WidgetLayout *parent, Card *card);
+    CardWidget(WidgetLayout *parent, const Card *card);
 
     void clickEnter() override {}
 
@@ -170,10 +185,22 @@ public:
     // helper for clean set position without recalculate bounding rect
     void resetPosition();
 
-    void setCard(Card *card);
+    void setCard(const Card *card);
+
+    // show a tarot instead of a card, null empties the slot
+    void setTarot(const Tarot *tarot);
+
+    // what shows above the widget when the score renders, a card sets its chips
+    void setScoreText(const char *text);
+
+    // raise the card, applied on the next click leave
+    void setSelected(bool selected);
 
     void setRenderScore(bool render_score);
 
+    // outline the card as part of the suggested play
+    void setSuggested(bool suggested);
+
     void draw(SDL_Renderer *renderer) override;
 };
 
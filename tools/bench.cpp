@@ -0,0 +1,163 @@
+// hand evaluation benchmark.
+// checks every 5 card hand against the reference predicates, then reports hands per second for
+// one hand at a time, the batch evaluator, and the batch evaluator on every core.
+// build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+// usage: card-game-bench [passes]
+
+#include "handevaluator.h"
+#include "handrules.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr size_t five_card_hands = 2598960;
+
+// how often each hand type shows up among all 5 card hands
+constexpr std::array<size_t, hand_type_count> expected_counts = {
+    1302540, // High Card
+    1098240, // Pair
+    123552,  // Two Pair
+    54912,   // Three of a Kind
+    10200,   // Straight
+    5108,    // Flush
+    3744,    // Full House
+    624,     // Four of a Kind
+    40,      // Straight Flush
+};
+
+std::vector<CardMask> allFiveCardHands()
+{
+    std::vector<CardMask> hands;
+    hands.reserve(five_card_hands);
+    // next bit permutation, walks every 52 bit mask with 5 bits set in order
+    CardMask mask = 0x1F;
+    while (mask < (CardMask(1) << 52))
+    {
+        hands.push_back(mask);
+        CardMask low = mask & -mask;
+        CardMask ripple = mask + low;
+        mask = ripple | (((mask ^ ripple) >> 2) / low);
+    }
+    return hands;
+}
+
+bool checkAgainstReference(const std::vector<CardMask> &hands)
+{
+    std::vector<HandResult> results(hands.size());
+    evaluateHandsParallel(hands.data(), results.data(), hands.size(), default_hand_ranks);
+
+    std::array<size_t, hand_type_count> counts{};
+    size_t mismatches = 0;
+    for (size_t i = 0; i < hands.size(); i++)
+    {
+        HandCounts reference;
+        HandMask single;
+        int chips = 0;
+        for (CardMask bits = hands[i]; bits != 0; bits &= bits - 1)
+        {
+            CardId card = std::countr_zero(bits);
+            reference.add(cardRank(card), cardSuit(card));
+            single.add(cardRank(card), cardSuit(card));
+            chips += getCardChips(cardRank(card));
+        }
+
+        HandType type = hand_rules::classify(reference);
+        const HandRank &rank = default_hand_ranks[static_cast<int>(type)];
+        bool ok = getHandType(results[i].value) == type && evaluateHand(single) == type &&
+                  lookupHand(single) == results[i].value &&
+                  results[i].score == (rank.chips + chips) * rank.multiplier;
+        if (!ok && mismatches++ < 10)
+        {
+            std::printf(
+                "mismatch: hand %016llx, reference %s, batch %s\n",
+                static_cast<unsigned long long>(hands[i]),
+                getHandName(type),
+                getHandName(getHandType(results[i].value))
+            );
+        }
+        counts[static_cast<int>(type)]++;
+    }
+
+    for (int i = 0; i < hand_type_count; i++)
+    {
+        bool ok = counts[i] == expected_counts[i];
+        mismatches += !ok;
+        std::printf(
+            "  %-16s %8zu%s\n",
+            hand_names[i],
+            counts[i],
+            ok ? "" : " (expected a different count)"
+        );
+    }
+    return mismatches == 0;
+}
+
+template <typename Run> double bestHandsPerSecond(int passes, size_t count, Run run)
+{
+    double best = 0;
+    for (int pass = 0; pass < passes; pass++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, count / elapsed.count());
+    }
+    return best;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int passes = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+    std::vector<CardMask> hands = allFiveCardHands();
+    std::vector<HandResult> results(hands.size());
+
+    std::printf("checking %zu hands against the reference predicates\n", hands.size());
+    if (hands.size() != five_card_hands || !checkAgainstReference(hands))
+    {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    std::printf("ok\n\n");
+
+    // one hand at a time, the way CardManager builds a hand card by card
+    double single = bestHandsPerSecond(passes, hands.size(), [&] {
+        for (size_t i = 0; i < hands.size(); i++)
+        {
+            HandMask hand;
+            int chips = 0;
+            for (CardMask bits = hands[i]; bits != 0; bits &= bits - 1)
+            {
+                CardId card = std::countr_zero(bits);
+                hand.add(cardRank(card), cardSuit(card));
+                chips += getCardChips(cardRank(card));
+            }
+            HandValue value = lookupHand(hand);
+            const HandRank &rank = default_hand_ranks[static_cast<int>(getHandType(value))];
+            results[i] = {value, (rank.chips + chips) * rank.multiplier};
+        }
+    });
+    double batch = bestHandsPerSecond(passes, hands.size(), [&] {
+        evaluateHands(hands.data(), results.data(), hands.size(), default_hand_ranks);
+    });
+    double all_cores = bestHandsPerSecond(passes, hands.size(), [&] {
+        evaluateHandsParallel(hands.data(), results.data(), hands.size(), default_hand_ranks);
+    });
+
+    std::printf("single hand : %12.0f hands/s\n", single);
+    std::printf("batch       : %12.0f hands/s\n", batch);
+    std::printf(
+        "all cores   : %12.0f hands/s (%u threads)\n",
+        all_cores,
+        std::max(1u, std::thread::hardware_concurrency())
+    );
+    return 0;
+}
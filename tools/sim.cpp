@@ -0,0 +1,445 @@
+// bot tournament, plays complete runs headless with simple strategies and reports how far they get.
+// run i always uses seed + i, so results don't depend on the thread count.
+// build with -DCMAKE_BUILD_TYPE=Release for meaningful numbers.
+//
+// usage: card-game-sim [--runs N] [--strategy random|greedy|discard|all] [--stages N]
+//                      [--threads N] [--seed N] [--tarots FILE]
+//
+// with --tarots every bot takes the tarots it can afford after each round won. the tarots are
+// checked first to score the same whichever order they were bought in.
+
+#include "gamestate.h"
+#include "random.h"
+#include "scorepipeline.h"
+#include "tarot.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr int max_stages_limit = 64;
+
+struct Options
+{
+    uint64_t runs = 10000;
+    std::string strategy = "all";
+    int stages = 8; // a run that clears this many stages counts as won
+    unsigned threads = 0;
+    uint64_t seed = 1;
+    std::string tarots_path;
+    const TarotEffects *tarots = nullptr; // loaded from tarots_path, shared by every worker
+};
+
+// one decision per call: select some cards, then play or discard them
+using Strategy = void (*)(GameRules &rules, Pcg32 &rng);
+
+void selectMask(GameRules &rules, uint64_t mask)
+{
+    for (uint64_t bits = mask; bits != 0; bits &= bits - 1)
+    {
+        rules.selectCard(std::countr_zero(bits));
+    }
+}
+
+// random selection of 1 to 5 cards, discarded half the time while discards last
+void playRandom(GameRules &rules, Pcg32 &rng)
+{
+    const CardManager &cards = rules.state.card_manager;
+    size_t hand_size = cards.m_hand_cards.size();
+    int count = 1 + rng.bounded(std::min<uint32_t>(max_play_cards, hand_size));
+
+    // partial Fisher-Yates over the hand indices
+    std::array<int, max_hand_cards> indices;
+    for (size_t i = 0; i < hand_size; i++)
+    {
+        indices[i] = i;
+    }
+    uint64_t mask = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int pick = i + rng.bounded(hand_size - i);
+        std::swap(indices[i], indices[pick]);
+        mask |= uint64_t(1) << indices[i];
+    }
+    selectMask(rules, mask);
+
+    if (rules.state.discard_counter > 0 && rng.bounded(2) == 0)
+    {
+        rules.discardSelectedCards();
+    }
+    else
+    {
+        rules.playHand();
+    }
+}
+
+// always play the highest scoring hand
+void playGreedy(GameRules &rules, Pcg32 &)
+{
+    selectMask(rules, rules.state.card_manager.findBestPlay().mask);
+    rules.playHand();
+}
+
+// play the best hand when the remaining plays can reach the target with it, otherwise keep the
+// best hand and discard up to 5 of the lowest other cards. a discard deals new cards, and one
+// left over pays coins after the round, so the estimate counts the tarots held.
+void playDiscardHeuristic(GameRules &rules, Pcg32 &)
+{
+    const GameState &state = rules.state;
+    const CardManager &cards = state.card_manager;
+    BestPlay best = rules.state.card_manager.findBestPlay();
+
+    int needed = state.target_score - state.score;
+    int estimate = rules.previewScore(best);
+    uint64_t hand_mask = (uint64_t(1) << cards.m_hand_cards.size()) - 1;
+    uint64_t rest = hand_mask & ~best.mask;
+    if (state.discard_counter > 0 && rest != 0 && estimate * state.play_counter < needed)
+    {
+        // the hand is sorted high to low, so the top bits are the lowest cards
+        uint64_t discard = 0;
+        for (int i = 0; i < max_play_cards && rest != 0; i++)
+        {
+            uint64_t lowest = uint64_t(1) << (63 - std::countl_zero(rest));
+            discard |= lowest;
+            rest &= ~lowest;
+        }
+        selectMask(rules, discard);
+        rules.discardSelectedCards();
+        return;
+    }
+
+    selectMask(rules, best.mask);
+    rules.playHand();
+}
+
+struct StrategyInfo
+{
+    const char *name;
+    Strategy play;
+};
+
+constexpr std::array<StrategyInfo, 3> strategies = {{
+    {"random", playRandom},
+    {"greedy", playGreedy},
+    {"discard", playDiscardHeuristic},
+}};
+
+struct Stats
+{
+    uint64_t runs = 0;
+    uint64_t wins = 0;
+    uint64_t total_score = 0;
+    uint64_t total_hands = 0;
+    std::array<uint64_t, max_stages_limit + 1> cleared{}; // runs that cleared at least n stages
+    std::array<uint64_t, hand_type_count> used{};
+
+    void merge(const Stats &other)
+    {
+        runs += other.runs;
+        wins += other.wins;
+        total_score += other.total_score;
+        total_hands += other.total_hands;
+        for (size_t i = 0; i < cleared.size(); i++)
+        {
+            cleared[i] += other.cleared[i];
+        }
+        for (size_t i = 0; i < used.size(); i++)
+        {
+            used[i] += other.used[i];
+        }
+    }
+};
+
+void playRun(
+    GameRules &rules,
+    Strategy strategy,
+    uint64_t seed,
+    int stages,
+    bool take_tarots,
+    Stats &stats
+)
+{
+    Pcg32 rng(seed, RandomStream::BOT);
+    rules.newGame(seed);
+    rules.newRound();
+
+    const GameState &state = rules.state;
+    uint64_t run_score = 0;
+    bool won = false;
+    while (state.phase != GamePhase::GAME_OVER)
+    {
+        if (state.phase == GamePhase::ROUND_WON)
+        {
+            run_score += state.score;
+            if (state.stage_counter > stages)
+            {
+                won = true;
+                break;
+            }
+            while (take_tarots && rules.takeTarot(0))
+            {
+            }
+            rules.newRound();
+            continue;
+        }
+        strategy(rules, rng);
+    }
+    if (!won)
+    {
+        run_score += state.score;
+    }
+
+    int cleared = std::min(state.stage_counter - 1, stages);
+    for (int i = 0; i <= cleared; i++)
+    {
+        stats.cleared[i]++;
+    }
+    stats.runs++;
+    stats.wins += won;
+    stats.total_score += run_score;
+    for (int i = 0; i < hand_type_count; i++)
+    {
+        stats.used[i] += state.card_manager.hand_ranks[i].used;
+        stats.total_hands += state.card_manager.hand_ranks[i].used;
+    }
+}
+
+Stats runTournament(const Options &options, Strategy strategy)
+{
+    unsigned threads = options.threads;
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // workers take runs in batches off a shared counter
+    constexpr uint64_t batch = 256;
+    std::atomic<uint64_t> next_run{0};
+    std::vector<Stats> results(threads);
+    auto worker = [&](Stats &stats) {
+        GameRules rules;
+        rules.setTarotEffects(options.tarots);
+        for (;;)
+        {
+            uint64_t first = next_run.fetch_add(batch);
+            if (first >= options.runs) break;
+            uint64_t last = std::min(options.runs, first + batch);
+            for (uint64_t run = first; run < last; run++)
+            {
+                playRun(
+                    rules,
+                    strategy,
+                    options.seed + run,
+                    options.stages,
+                    options.tarots != nullptr,
+                    stats
+                );
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        workers.emplace_back(worker, std::ref(results[t]));
+    }
+    worker(results[0]);
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+
+    Stats total;
+    for (const Stats &stats : results)
+    {
+        total.merge(stats);
+    }
+    return total;
+}
+
+void printStats(const char *name, const Stats &stats, int stages, double seconds)
+{
+    double runs = std::max<uint64_t>(stats.runs, 1);
+    std::printf(
+        "%s: %llu runs in %.2fs (%.0f runs/s)\n",
+        name,
+        static_cast<unsigned long long>(stats.runs),
+        seconds,
+        stats.runs / seconds
+    );
+    std::printf("  won        %6.2f%%\n", 100.0 * stats.wins / runs);
+    std::printf("  avg score  %.1f\n", stats.total_score / runs);
+    for (int stage = 1; stage <= stages; stage++)
+    {
+        std::printf("  stage %-4d %6.2f%% cleared\n", stage, 100.0 * stats.cleared[stage] / runs);
+    }
+    std::printf("  hands played\n");
+    double hands = std::max<uint64_t>(stats.total_hands, 1);
+    for (int i = 0; i < hand_type_count; i++)
+    {
+        std::printf("    %-16s %6.2f%%\n", hand_names[i], 100.0 * stats.used[i] / hands);
+    }
+}
+
+bool sameDelta(const StageDelta &a, const StageDelta &b)
+{
+    return a.chips == b.chips && a.mult == b.mult && a.times == b.times &&
+           a.retrigger == b.retrigger;
+}
+
+// every pair of tarots held in both orders. two that convert suits are left out, the one held
+// last decides the suit.
+bool checkHeldOrder(const TarotEffects &effects)
+{
+    auto forward = std::make_unique<TarotPipeline>();
+    auto backward = std::make_unique<TarotPipeline>();
+    size_t mismatches = 0;
+    for (TarotId a = 0; a < tarot_count; a++)
+    {
+        for (TarotId b = a + 1; b < tarot_count; b++)
+        {
+            if (convertsSuit(effects, a) && convertsSuit(effects, b)) continue;
+
+            FixedList<TarotId, max_hand_tarots> held;
+            held.push_back(a);
+            held.push_back(b);
+            compileTarotPipeline(effects, held, *forward);
+            held[0] = b;
+            held[1] = a;
+            compileTarotPipeline(effects, held, *backward);
+
+            bool same = true;
+            for (int type = 0; type < hand_type_count; type++)
+            {
+                for (int count = 0; count < max_play_cards; count++)
+                {
+                    same &= sameDelta(forward->hand[type][count], backward->hand[type][count]);
+                    for (CardId id = 0; id < deck_size; id++)
+                    {
+                        same &= sameDelta(
+                            forward->card[id][type][count],
+                            backward->card[id][type][count]
+                        );
+                    }
+                }
+            }
+            if (!same && mismatches++ < 10)
+            {
+                std::printf(
+                    "held order matters: %s and %s\n",
+                    std::string(tarot_names[a]).c_str(),
+                    std::string(tarot_names[b]).c_str()
+                );
+            }
+        }
+    }
+    return mismatches == 0;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        uint64_t number = 0;
+        if (std::strcmp(arg, "--strategy") == 0 && value)
+        {
+            options.strategy = value;
+        }
+        else if (std::strcmp(arg, "--tarots") == 0 && value)
+        {
+            options.tarots_path = value;
+        }
+        else if (value && parseSeed(value, number))
+        {
+            if (std::strcmp(arg, "--runs") == 0)
+            {
+                options.runs = number;
+            }
+            else if (std::strcmp(arg, "--stages") == 0)
+            {
+                options.stages = std::clamp<uint64_t>(number, 1, max_stages_limit);
+            }
+            else if (std::strcmp(arg, "--threads") == 0)
+            {
+                options.threads = number;
+            }
+            else if (std::strcmp(arg, "--seed") == 0)
+            {
+                options.seed = number;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::fprintf(
+            stderr,
+            "usage: %s [--runs N] [--strategy random|greedy|discard|all] [--stages N] "
+            "[--threads N] [--seed N] [--tarots FILE]\n",
+            argv[0]
+        );
+        return 1;
+    }
+
+    TarotEffects tarots;
+    if (!options.tarots_path.empty())
+    {
+        std::string error;
+        if (!loadTarotEffects(options.tarots_path, tarots, error))
+        {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        options.tarots = &tarots;
+        if (!checkHeldOrder(tarots))
+        {
+            std::printf("FAILED\n");
+            return 1;
+        }
+    }
+
+    bool found = false;
+    for (const StrategyInfo &strategy : strategies)
+    {
+        if (options.strategy != "all" && options.strategy != strategy.name) continue;
+        found = true;
+
+        auto start = std::chrono::steady_clock::now();
+        Stats stats = runTournament(options, strategy.play);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        printStats(strategy.name, stats, options.stages, elapsed.count());
+    }
+    if (!found)
+    {
+        std::fprintf(stderr, "unknown strategy %s\n", options.strategy.c_str());
+        return 1;
+    }
+    return 0;
+}